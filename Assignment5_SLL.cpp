@@ -1,4 +1,12 @@
 #include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+#include "OutputSink.h"
 
 using namespace std;
 
@@ -13,79 +21,261 @@ struct Node {
     Node() : data(0), next(nullptr) {}
 };
 
-// Global head pointer for the Q1 Menu-Driven program
-Node* headQ1 = nullptr;
+// --- List Handle (head, tail and cached size) ---
+// Keeping the tail and size alongside the head makes append and size O(1),
+// and lets several independent lists exist at once.
+struct SinglyList {
+    Node* head;
+    Node* tail;
+    int size;
+
+    SinglyList() : head(nullptr), tail(nullptr), size(0) {}
+};
+
+// List handle for the Q1 Menu-Driven program
+SinglyList listQ1;
+
+// --- Forward Iterator over Node chains ---
+// Lets std:: algorithms (find, count, distance, accumulate, ...) walk a list
+// directly instead of hand-written loops over raw 'next' pointers.
+struct NodeIterator {
+    using iterator_category = forward_iterator_tag;
+    using value_type = int;
+    using difference_type = ptrdiff_t;
+    using pointer = int*;
+    using reference = int&;
+
+    Node* node;
+
+    NodeIterator(Node* n = nullptr) : node(n) {}
+    reference operator*() const { return node->data; }
+    pointer operator->() const { return &node->data; }
+    NodeIterator& operator++() { node = node->next; return *this; }
+    NodeIterator operator++(int) { NodeIterator old = *this; node = node->next; return old; }
+    bool operator==(const NodeIterator& other) const { return node == other.node; }
+    bool operator!=(const NodeIterator& other) const { return node != other.node; }
+};
+
+// Range over a raw head pointer (used by the Q2, Q3, Q4 style lists)
+struct NodeRange {
+    Node* head;
+
+    NodeIterator begin() const { return NodeIterator(head); }
+    NodeIterator end() const { return NodeIterator(nullptr); }
+};
+
+NodeIterator begin(const SinglyList& list) { return NodeIterator(list.head); }
+NodeIterator end(const SinglyList&) { return NodeIterator(nullptr); }
+
+// Size and search over any raw head, expressed as generic algorithms
+int listSize(Node* head) {
+    NodeRange range{head};
+    return (int)distance(range.begin(), range.end());
+}
+
+// 1-based position of the first node holding value, or -1 when not found
+int listSearch(Node* head, int value) {
+    NodeRange range{head};
+    NodeIterator it = find(range.begin(), range.end(), value);
+    return it == range.end() ? -1 : (int)distance(range.begin(), it) + 1;
+}
+
+// ==========================================================
+// --- Node Pool (Slab / Free-List Allocator) ---
+// ==========================================================
+
+// Nodes are carved out of fixed-size slabs instead of individual new/delete calls.
+// Released nodes are threaded onto a free list through their own 'next' pointer,
+// so the next allocation reuses them without touching malloc.
+const int NODE_POOL_SLAB_SIZE = 4096;
+
+struct NodeSlab {
+    Node nodes[NODE_POOL_SLAB_SIZE];
+    NodeSlab* nextSlab;
+};
+
+struct NodePool {
+    NodeSlab* slabs;     // All slabs owned by the pool (linked together)
+    Node* freeList;      // Released nodes waiting for reuse
+    int bumpIndex;       // Next never-used node inside the newest slab
+
+    // Counter surface
+    long long liveNodes;
+    long long slabCount;
+    long long reuseHits;
+    long long totalAllocations;
+
+    NodePool() : slabs(nullptr), freeList(nullptr), bumpIndex(NODE_POOL_SLAB_SIZE),
+                 liveNodes(0), slabCount(0), reuseHits(0), totalAllocations(0) {}
+};
+
+// Shared pool used by every list in this program
+NodePool nodePool;
+
+Node* poolAllocate(NodePool& pool, int val) {
+    Node* node;
+    if (pool.freeList != nullptr) {
+        // Reuse a previously released node
+        node = pool.freeList;
+        pool.freeList = node->next;
+        pool.reuseHits++;
+    } else {
+        if (pool.bumpIndex == NODE_POOL_SLAB_SIZE) {
+            // Current slab exhausted: grab a fresh one
+            NodeSlab* slab = new NodeSlab();
+            slab->nextSlab = pool.slabs;
+            pool.slabs = slab;
+            pool.slabCount++;
+            pool.bumpIndex = 0;
+        }
+        node = &pool.slabs->nodes[pool.bumpIndex++];
+    }
+    node->data = val;
+    node->next = nullptr;
+    pool.liveNodes++;
+    pool.totalAllocations++;
+    return node;
+}
+
+void poolRelease(NodePool& pool, Node* node) {
+    node->next = pool.freeList;
+    pool.freeList = node;
+    pool.liveNodes--;
+}
+
+// O(1) bulk release: splices an already linked chain first..last (count nodes)
+// onto the free list in one step.
+void poolReleaseChain(NodePool& pool, Node* first, Node* last, long long count) {
+    if (first == nullptr) return;
+    last->next = pool.freeList;
+    pool.freeList = first;
+    pool.liveNodes -= count;
+}
+
+// Returns every slab to the system and resets the counters, so a pool that is
+// used again afterwards starts from fresh stats. Only valid once no list uses the pool.
+void poolDestroy(NodePool& pool) {
+    while (pool.slabs != nullptr) {
+        NodeSlab* temp = pool.slabs;
+        pool.slabs = pool.slabs->nextSlab;
+        delete temp;
+    }
+    pool.freeList = nullptr;
+    pool.bumpIndex = NODE_POOL_SLAB_SIZE;
+    pool.liveNodes = 0;
+    pool.slabCount = 0;
+    pool.reuseHits = 0;
+    pool.totalAllocations = 0;
+}
+
+void printPoolStats(const NodePool& pool) {
+    cout << "Node Pool -> live nodes: " << pool.liveNodes
+         << ", slabs: " << pool.slabCount
+         << ", reuse hits: " << pool.reuseHits
+         << ", total allocations: " << pool.totalAllocations << endl;
+}
+
+// Convenience wrappers used throughout the program
+Node* allocNode(int val) {
+    return poolAllocate(nodePool, val);
+}
+
+void freeNode(Node* node) {
+    poolRelease(nodePool, node);
+}
 
 // --- Utility Functions (Used for display and cleanup) ---
 
-void printList(Node* head) {
+void printList(Node* head, ostream& out = cout) {
+    OutputSink& sink = outputSink(out);
     if (head == nullptr) {
-        cout << "List is empty (NULL)";
+        sink.text("List is empty (NULL)");
+        sink.flush();
         return;
     }
     Node* current = head;
     while (current != nullptr) {
-        cout << current->data;
+        sink.integer(current->data);
         if (current->next != nullptr) {
-            cout << " -> ";
+            sink.text(" -> ", 4);
         }
         current = current->next;
     }
-    cout << " -> NULL";
+    sink.text(" -> NULL", 8);
+    sink.flush();
+}
+
+// Raw binary dump: the node values as consecutive native ints, no formatting
+void dumpListBinary(Node* head, ostream& out) {
+    OutputSink& sink = outputSink(out);
+    for (Node* current = head; current != nullptr; current = current->next) {
+        sink.binary(&current->data, sizeof(current->data));
+    }
+    sink.flush();
 }
 
+// Releases a list known only by its head. A bare head carries no tail or
+// size, so this walks the chain once (O(n)) and then splices it back in one
+// step; lists kept in a SinglyList handle use the O(1) clearList below.
 void cleanupList(Node*& head) {
-    Node* current = head;
-    Node* nextNode = nullptr;
-    while (current != nullptr) {
-        nextNode = current->next;
-        delete current;
-        current = nextNode;
+    if (head == nullptr) return;
+    // Find the tail (and count) so the whole chain is handed back in one splice
+    Node* tail = head;
+    long long count = 1;
+    while (tail->next != nullptr) {
+        tail = tail->next;
+        count++;
     }
+    poolReleaseChain(nodePool, head, tail, count);
     head = nullptr;
 }
 
+// O(1) cleanup for a list handle: head, tail and size are already known
+void clearList(SinglyList& list) {
+    poolReleaseChain(nodePool, list.head, list.tail, list.size);
+    list.head = nullptr;
+    list.tail = nullptr;
+    list.size = 0;
+}
+
 
 // ==========================================================
 // --- Q1: Menu Driven Program Operations ---
 // ==========================================================
 
 Node* createNodeQ1(int data) {
-    Node* newNode = new Node();
-    // Assuming successful allocation or using try/catch in a real environment
-    newNode->data = data;
-    newNode->next = nullptr;
-    return newNode;
+    // Nodes come from the shared slab pool instead of the heap
+    return allocNode(data);
 }
 
 // (a) Insertion at the beginning
-void insertAtBeginningQ1(int data) {
+void insertAtBeginningQ1(SinglyList& list, int data) {
     Node* newNode = createNodeQ1(data);
-    newNode->next = headQ1;
-    headQ1 = newNode;
+    newNode->next = list.head;
+    list.head = newNode;
+    if (list.tail == nullptr) {
+        list.tail = newNode; // First node is both head and tail
+    }
+    list.size++;
     cout << "Node " << data << " inserted at the beginning." << endl;
 }
 
-// (b) Insertion at the end
-void insertAtEndQ1(int data) {
+// (b) Insertion at the end (O(1) through the tail pointer)
+void insertAtEndQ1(SinglyList& list, int data) {
     Node* newNode = createNodeQ1(data);
-    if (headQ1 == nullptr) {
-        headQ1 = newNode;
-        cout << "Node " << data << " inserted at the end." << endl;
-        return;
-    }
-    Node* current = headQ1;
-    while (current->next != nullptr) {
-        current = current->next;
+    if (list.tail == nullptr) {
+        list.head = newNode;
+    } else {
+        list.tail->next = newNode;
     }
-    current->next = newNode;
+    list.tail = newNode;
+    list.size++;
     cout << "Node " << data << " inserted at the end." << endl;
 }
 
 // (c) Insertion in between (before or after a node having a specific value)
-void insertInBetweenQ1(int newData, int targetValue, bool insertAfter) {
-    Node* newNode = createNodeQ1(newData);
-    Node* current = headQ1;
+void insertInBetweenQ1(SinglyList& list, int newData, int targetValue, bool insertAfter) {
+    Node* current = list.head;
     Node* prev = nullptr;
     bool found = false;
 
@@ -100,21 +290,24 @@ void insertInBetweenQ1(int newData, int targetValue, bool insertAfter) {
 
     if (!found) {
         cout << "Error: Node with value " << targetValue << " not found." << endl;
-        delete newNode;
         return;
     }
 
+    Node* newNode = createNodeQ1(newData);
     if (insertAfter) {
         // Insert AFTER the target node (current)
         newNode->next = current->next;
         current->next = newNode;
+        if (current == list.tail) {
+            list.tail = newNode; // Appended past the old tail
+        }
         cout << "Node " << newData << " inserted AFTER node " << targetValue << "." << endl;
     } else {
         // Insert BEFORE the target node (current)
         if (prev == nullptr) {
             // Target is the head node
-            newNode->next = headQ1;
-            headQ1 = newNode;
+            newNode->next = list.head;
+            list.head = newNode;
         } else {
             // Target is in the middle
             newNode->next = current;
@@ -122,106 +315,107 @@ void insertInBetweenQ1(int newData, int targetValue, bool insertAfter) {
         }
         cout << "Node " << newData << " inserted BEFORE node " << targetValue << "." << endl;
     }
+    list.size++;
 }
 
 // (d) Deletion from the beginning
-void deleteFromBeginningQ1() {
-    if (headQ1 == nullptr) {
+void deleteFromBeginningQ1(SinglyList& list) {
+    if (list.head == nullptr) {
         cout << "List is empty. Cannot delete." << endl;
         return;
     }
-    Node* temp = headQ1;
-    headQ1 = headQ1->next;
+    Node* temp = list.head;
+    list.head = list.head->next;
+    if (list.head == nullptr) {
+        list.tail = nullptr;
+    }
+    list.size--;
     cout << "Deleted node with value: " << temp->data << " from the beginning." << endl;
-    delete temp;
+    freeNode(temp);
 }
 
 // (e) Deletion from the end
-void deleteFromEndQ1() {
-    if (headQ1 == nullptr) {
+// A singly linked node has no back pointer, so the new tail still has to be found
+// by walking from the head; the cached size lets us stop exactly one node early.
+void deleteFromEndQ1(SinglyList& list) {
+    if (list.head == nullptr) {
         cout << "List is empty. Cannot delete." << endl;
         return;
     }
-    if (headQ1->next == nullptr) {
+    Node* oldTail = list.tail;
+    if (list.head == list.tail) {
         // Only one node
-        cout << "Deleted node with value: " << headQ1->data << " from the end." << endl;
-        delete headQ1;
-        headQ1 = nullptr;
-        return;
-    }
-    Node* current = headQ1;
-    Node* prev = nullptr;
-    while (current->next != nullptr) {
-        prev = current;
-        current = current->next;
+        list.head = nullptr;
+        list.tail = nullptr;
+    } else {
+        Node* prev = list.head;
+        for (int i = 1; i < list.size - 1; ++i) {
+            prev = prev->next;
+        }
+        prev->next = nullptr;
+        list.tail = prev;
     }
-    prev->next = nullptr;
-    cout << "Deleted node with value: " << current->data << " from the end." << endl;
-    delete current;
+    list.size--;
+    cout << "Deleted node with value: " << oldTail->data << " from the end." << endl;
+    freeNode(oldTail);
 }
 
 // (f) Deletion of a specific node
-void deleteSpecificNodeQ1(int targetValue) {
-    if (headQ1 == nullptr) {
+void deleteSpecificNodeQ1(SinglyList& list, int targetValue) {
+    if (list.head == nullptr) {
         cout << "List is empty. Cannot delete." << endl;
         return;
     }
 
-    Node* current = headQ1;
+    Node* current = list.head;
     Node* prev = nullptr;
 
-    // Case 1: Target is the head node
-    if (current != nullptr && current->data == targetValue) {
-        headQ1 = current->next;
-        cout << "Deleted node with value: " << current->data << "." << endl;
-        delete current;
-        return;
-    }
-
     // Search for the target node
     while (current != nullptr && current->data != targetValue) {
         prev = current;
         current = current->next;
     }
 
-    // Case 2: Target not found
+    // Case 1: Target not found
     if (current == nullptr) {
         cout << "Error: Node with value " << targetValue << " not found." << endl;
         return;
     }
 
-    // Case 3: Target found in the middle or end
-    prev->next = current->next;
+    // Case 2: Target is the head node; Case 3: target in the middle or end
+    if (prev == nullptr) {
+        list.head = current->next;
+    } else {
+        prev->next = current->next;
+    }
+    if (current == list.tail) {
+        list.tail = prev;
+    }
+    list.size--;
     cout << "Deleted node with value: " << current->data << "." << endl;
-    delete current;
+    freeNode(current);
 }
 
 // (g) Search for a node and display its position from head
-void searchNodeQ1(int targetValue) {
-    if (headQ1 == nullptr) {
+void searchNodeQ1(const SinglyList& list, int targetValue) {
+    if (list.head == nullptr) {
         cout << "List is empty. Search failed." << endl;
         return;
     }
-    Node* current = headQ1;
-    int position = 1;
-
-    while (current != nullptr) {
-        if (current->data == targetValue) {
-            cout << "Node with value " << targetValue << " found at position " << position << "." << endl;
-            return;
-        }
-        current = current->next;
-        position++;
+    int position = listSearch(list.head, targetValue);
+    if (position != -1) {
+        cout << "Node with value " << targetValue << " found at position " << position << "." << endl;
+        return;
     }
 
     cout << "Node with value " << targetValue << " not found in the list." << endl;
 }
 
 // (h) Display all the node values
-void displayListQ1() {
+void displayListQ1(const SinglyList& list) {
     cout << "Q1 Linked List: ";
-    printList(headQ1);
-    cout << endl;
+    printList(list.head);
+    cout << " (size " << list.size << ")" << endl;
 }
 
 // ==========================================================
@@ -241,7 +435,7 @@ int deleteAllOccurrences(Node*& head, int key) {
         Node* temp = current;
         head = current->next;
         current = head;
-        delete temp;
+        freeNode(temp);
         count++;
     }
 
@@ -258,7 +452,7 @@ int deleteAllOccurrences(Node*& head, int key) {
             Node* temp = current;
             prev->next = current->next; // Bypass the node
             current = current->next;    // Move current
-            delete temp;
+            freeNode(temp);
             count++;
         } else {
             prev = current;             // Advance prev
@@ -309,17 +503,782 @@ Node* reverseList(Node* head) {
     return prev; // New head of the reversed list
 }
 
+// ==========================================================
+// --- SIMD Search / Compaction Kernels (contiguous storage) ---
+// ==========================================================
+
+// Kernels over a plain int array: find the first position of a key and compact
+// out every occurrence of a key while keeping the survivors in their original
+// order. The AVX2 / SSE4.1 versions are compiled with per-function target
+// attributes and picked at runtime from the CPU's feature flags; every other
+// platform (or an old CPU) uses the scalar loops.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SLL_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+int findFirstScalar(const int* data, int n, int key) {
+    for (int i = 0; i < n; ++i) {
+        if (data[i] == key) return i;
+    }
+    return -1;
+}
+
+int compactOutScalar(int* data, int n, int key) {
+    int out = 0;
+    for (int i = 0; i < n; ++i) {
+        if (data[i] != key) {
+            data[out++] = data[i];
+        }
+    }
+    return out;
+}
+
+#ifdef SLL_HAVE_X86_SIMD
+
+// Shuffle tables: for each lane keep-mask, the lane indices of kept values packed to the front
+alignas(32) int avx2CompactTable[256][8];
+alignas(16) unsigned char sseCompactTable[16][16];
+
+void buildCompactTables() {
+    for (int mask = 0; mask < 256; ++mask) {
+        int k = 0;
+        for (int lane = 0; lane < 8; ++lane) {
+            if (mask & (1 << lane)) avx2CompactTable[mask][k++] = lane;
+        }
+        while (k < 8) avx2CompactTable[mask][k++] = 0;
+    }
+    for (int mask = 0; mask < 16; ++mask) {
+        int k = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            if (mask & (1 << lane)) {
+                for (int b = 0; b < 4; ++b) sseCompactTable[mask][k * 4 + b] = (unsigned char)(lane * 4 + b);
+                k++;
+            }
+        }
+        for (int b = k * 4; b < 16; ++b) sseCompactTable[mask][b] = 0x80; // Zero-fill
+    }
+}
+
+__attribute__((target("avx2")))
+int findFirstAVX2(const int* data, int n, int key) {
+    __m256i needle = _mm256_set1_epi32(key);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle)));
+        if (mask != 0) return i + __builtin_ctz(mask);
+    }
+    int tail = findFirstScalar(data + i, n - i, key);
+    return tail == -1 ? -1 : i + tail;
+}
+
+// In-place is safe: the 8-lane store at 'out' never reaches past i + 7, and
+// those lanes have already been loaded into the register.
+__attribute__((target("avx2")))
+int compactOutAVX2(int* data, int n, int key) {
+    __m256i needle = _mm256_set1_epi32(key);
+    int i = 0;
+    int out = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+        int dropMask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle)));
+        int keepMask = ~dropMask & 0xFF;
+        __m256i perm = _mm256_load_si256((const __m256i*)avx2CompactTable[keepMask]);
+        _mm256_storeu_si256((__m256i*)(data + out), _mm256_permutevar8x32_epi32(block, perm));
+        out += __builtin_popcount(keepMask);
+    }
+    for (; i < n; ++i) {
+        if (data[i] != key) data[out++] = data[i];
+    }
+    return out;
+}
+
+__attribute__((target("sse4.1")))
+int findFirstSSE4(const int* data, int n, int key) {
+    __m128i needle = _mm_set1_epi32(key);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, needle)));
+        if (mask != 0) return i + __builtin_ctz(mask);
+    }
+    int tail = findFirstScalar(data + i, n - i, key);
+    return tail == -1 ? -1 : i + tail;
+}
+
+__attribute__((target("sse4.1")))
+int compactOutSSE4(int* data, int n, int key) {
+    __m128i needle = _mm_set1_epi32(key);
+    int i = 0;
+    int out = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+        int dropMask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, needle)));
+        int keepMask = ~dropMask & 0xF;
+        __m128i shuffle = _mm_load_si128((const __m128i*)sseCompactTable[keepMask]);
+        _mm_storeu_si128((__m128i*)(data + out), _mm_shuffle_epi8(block, shuffle));
+        out += __builtin_popcount(keepMask);
+    }
+    for (; i < n; ++i) {
+        if (data[i] != key) data[out++] = data[i];
+    }
+    return out;
+}
+
+#endif
+
+// Runtime-selected kernels (scalar until selectSimdKernels() runs)
+int (*findFirstInt)(const int*, int, int) = findFirstScalar;
+int (*compactOutInt)(int*, int, int) = compactOutScalar;
+const char* simdKernelName = "scalar";
+
+void selectSimdKernels() {
+#ifdef SLL_HAVE_X86_SIMD
+    __builtin_cpu_init();
+    buildCompactTables();
+    if (__builtin_cpu_supports("avx2")) {
+        findFirstInt = findFirstAVX2;
+        compactOutInt = compactOutAVX2;
+        simdKernelName = "AVX2";
+    } else if (__builtin_cpu_supports("sse4.1")) {
+        findFirstInt = findFirstSSE4;
+        compactOutInt = compactOutSSE4;
+        simdKernelName = "SSE4.1";
+    }
+#endif
+}
+
+// ==========================================================
+// --- Unrolled Linked List (cache-friendly variant of Q1) ---
+// ==========================================================
+
+// Each block packs several ints plus a count and a next pointer into one 64-byte
+// cache line, so a scan touches one line per UNROLLED_BLOCK_CAPACITY elements
+// instead of one line per element.
+const int UNROLLED_BLOCK_CAPACITY = (64 - (int)sizeof(void*) - (int)sizeof(int)) / (int)sizeof(int);
+
+struct alignas(64) UnrolledBlock {
+    int count;
+    int values[UNROLLED_BLOCK_CAPACITY];
+    UnrolledBlock* next;
+
+    UnrolledBlock() : count(0), next(nullptr) {}
+};
+
+struct UnrolledList {
+    UnrolledBlock* head;
+    UnrolledBlock* tail;
+    int size;
+
+    UnrolledList() : head(nullptr), tail(nullptr), size(0) {}
+};
+
+void cleanupUnrolled(UnrolledList& list) {
+    UnrolledBlock* current = list.head;
+    while (current != nullptr) {
+        UnrolledBlock* nextBlock = current->next;
+        delete current;
+        current = nextBlock;
+    }
+    list.head = nullptr;
+    list.tail = nullptr;
+    list.size = 0;
+}
+
+void printUnrolled(const UnrolledList& list) {
+    if (list.head == nullptr) {
+        cout << "List is empty (NULL)";
+        return;
+    }
+    for (UnrolledBlock* block = list.head; block != nullptr; block = block->next) {
+        cout << "[";
+        for (int i = 0; i < block->count; ++i) {
+            cout << block->values[i];
+            if (i < block->count - 1) {
+                cout << " ";
+            }
+        }
+        cout << "] -> ";
+    }
+    cout << "NULL";
+}
+
+// Inserts value at slot 'index' of 'block'. A full block is split in half first,
+// with the upper half moved into a new block linked right after it.
+void unrolledInsertAt(UnrolledList& list, UnrolledBlock* block, int index, int value) {
+    if (block->count == UNROLLED_BLOCK_CAPACITY) {
+        UnrolledBlock* newBlock = new UnrolledBlock();
+        int half = UNROLLED_BLOCK_CAPACITY / 2;
+        for (int i = half; i < block->count; ++i) {
+            newBlock->values[newBlock->count++] = block->values[i];
+        }
+        block->count = half;
+        newBlock->next = block->next;
+        block->next = newBlock;
+        if (list.tail == block) {
+            list.tail = newBlock;
+        }
+        if (index > half) {
+            block = newBlock;
+            index -= half;
+        }
+    }
+    for (int i = block->count; i > index; --i) {
+        block->values[i] = block->values[i - 1];
+    }
+    block->values[index] = value;
+    block->count++;
+    list.size++;
+}
+
+// Removes slot 'index' of 'block' (prev is the block before it, or nullptr for head).
+// Empty blocks are unlinked and sparse neighbours are merged to keep blocks dense.
+void unrolledRemoveAt(UnrolledList& list, UnrolledBlock* prev, UnrolledBlock* block, int index) {
+    for (int i = index; i < block->count - 1; ++i) {
+        block->values[i] = block->values[i + 1];
+    }
+    block->count--;
+    list.size--;
+
+    if (block->count == 0) {
+        if (prev == nullptr) {
+            list.head = block->next;
+        } else {
+            prev->next = block->next;
+        }
+        if (list.tail == block) {
+            list.tail = prev;
+        }
+        delete block;
+        return;
+    }
+
+    UnrolledBlock* nextBlock = block->next;
+    if (nextBlock != nullptr && block->count + nextBlock->count <= UNROLLED_BLOCK_CAPACITY) {
+        for (int i = 0; i < nextBlock->count; ++i) {
+            block->values[block->count++] = nextBlock->values[i];
+        }
+        block->next = nextBlock->next;
+        if (list.tail == nextBlock) {
+            list.tail = block;
+        }
+        delete nextBlock;
+    }
+}
+
+// Locates the first occurrence of value. Returns its 1-based position, or -1.
+int unrolledFind(const UnrolledList& list, int value, UnrolledBlock*& prevOut,
+                 UnrolledBlock*& blockOut, int& indexOut) {
+    UnrolledBlock* prev = nullptr;
+    int position = 1;
+    for (UnrolledBlock* block = list.head; block != nullptr; block = block->next) {
+        int i = findFirstInt(block->values, block->count, value);
+        if (i != -1) {
+            prevOut = prev;
+            blockOut = block;
+            indexOut = i;
+            return position + i;
+        }
+        position += block->count;
+        prev = block;
+    }
+    return -1;
+}
+
+// (a) Insertion at the beginning
+void unrolledInsertAtBeginning(UnrolledList& list, int value) {
+    if (list.head == nullptr) {
+        list.head = list.tail = new UnrolledBlock();
+    }
+    unrolledInsertAt(list, list.head, 0, value);
+}
+
+// (b) Insertion at the end
+void unrolledInsertAtEnd(UnrolledList& list, int value) {
+    if (list.tail == nullptr) {
+        list.head = list.tail = new UnrolledBlock();
+    } else if (list.tail->count == UNROLLED_BLOCK_CAPACITY) {
+        // Start a fresh block rather than splitting, so appends keep blocks full
+        UnrolledBlock* newBlock = new UnrolledBlock();
+        list.tail->next = newBlock;
+        list.tail = newBlock;
+    }
+    unrolledInsertAt(list, list.tail, list.tail->count, value);
+}
+
+// (c) Insertion before or after the first node having a specific value
+bool unrolledInsertInBetween(UnrolledList& list, int newValue, int targetValue, bool insertAfter) {
+    UnrolledBlock* prev = nullptr;
+    UnrolledBlock* block = nullptr;
+    int index = 0;
+    if (unrolledFind(list, targetValue, prev, block, index) == -1) {
+        return false;
+    }
+    unrolledInsertAt(list, block, insertAfter ? index + 1 : index, newValue);
+    return true;
+}
+
+// (d) Deletion from the beginning
+bool unrolledDeleteFromBeginning(UnrolledList& list) {
+    if (list.head == nullptr) {
+        return false;
+    }
+    unrolledRemoveAt(list, nullptr, list.head, 0);
+    return true;
+}
+
+// (e) Deletion from the end
+// Only emptying the tail block needs its predecessor, so the block walk is
+// skipped while the tail still holds other values.
+bool unrolledDeleteFromEnd(UnrolledList& list) {
+    if (list.tail == nullptr) {
+        return false;
+    }
+    UnrolledBlock* prev = nullptr;
+    if (list.tail->count == 1) {
+        for (UnrolledBlock* block = list.head; block != list.tail; block = block->next) {
+            prev = block;
+        }
+    }
+    unrolledRemoveAt(list, prev, list.tail, list.tail->count - 1);
+    return true;
+}
+
+// (f) Deletion of the first node having a specific value
+bool unrolledDeleteValue(UnrolledList& list, int value) {
+    UnrolledBlock* prev = nullptr;
+    UnrolledBlock* block = nullptr;
+    int index = 0;
+    if (unrolledFind(list, value, prev, block, index) == -1) {
+        return false;
+    }
+    unrolledRemoveAt(list, prev, block, index);
+    return true;
+}
+
+// (g) Search: 1-based position from head, or -1 when not found
+int unrolledSearch(const UnrolledList& list, int value) {
+    UnrolledBlock* prev = nullptr;
+    UnrolledBlock* block = nullptr;
+    int index = 0;
+    return unrolledFind(list, value, prev, block, index);
+}
+
+// Q2 equivalent: delete all occurrences of key, compacting each block in bulk.
+// Returns the number of removed values; survivors keep their original order.
+int unrolledDeleteAllOccurrences(UnrolledList& list, int key) {
+    int count = 0;
+    UnrolledBlock* prev = nullptr;
+    UnrolledBlock* block = list.head;
+    while (block != nullptr) {
+        int kept = compactOutInt(block->values, block->count, key);
+        count += block->count - kept;
+        block->count = kept;
+        UnrolledBlock* nextBlock = block->next;
+        if (kept == 0) {
+            // Unlink blocks that became empty
+            if (prev == nullptr) list.head = nextBlock;
+            else prev->next = nextBlock;
+            delete block;
+        } else {
+            prev = block;
+        }
+        block = nextBlock;
+    }
+    list.tail = prev;
+    list.size -= count;
+    return count;
+}
+
+// Q3 equivalent: middle element (second middle for even lengths, like findMiddle)
+bool unrolledMiddle(const UnrolledList& list, int& middleOut) {
+    if (list.size == 0) {
+        return false;
+    }
+    int target = list.size / 2;
+    UnrolledBlock* block = list.head;
+    // Whole blocks are skipped using their counts, no per-element hops
+    while (target >= block->count) {
+        target -= block->count;
+        block = block->next;
+    }
+    middleOut = block->values[target];
+    return true;
+}
+
+// Q4 equivalent: reverse the block chain and the values inside each block
+void unrolledReverse(UnrolledList& list) {
+    UnrolledBlock* prev = nullptr;
+    UnrolledBlock* current = list.head;
+    list.tail = list.head;
+    while (current != nullptr) {
+        for (int i = 0, j = current->count - 1; i < j; ++i, --j) {
+            int temp = current->values[i];
+            current->values[i] = current->values[j];
+            current->values[j] = temp;
+        }
+        UnrolledBlock* nextBlock = current->next;
+        current->next = prev;
+        prev = current;
+        current = nextBlock;
+    }
+    list.head = prev;
+}
+
+// ==========================================================
+// --- Lock-Free Concurrent List (Harris/Michael with Hazard Pointers) ---
+// ==========================================================
+
+// A list that many threads can use at once. Each next pointer is atomic and its
+// lowest bit is the "logically deleted" mark (Harris): a delete first marks the
+// victim's next pointer, then unlinks it with a CAS on the predecessor. Any
+// traversal that meets a marked node helps unlink it. Unlinked nodes are only
+// freed once no thread's hazard pointers reference them (Michael's hazard pointers).
+// Every thread must take a slot with concurrentAcquireSlot() before using the list.
+const int CONCURRENT_MAX_THREADS = 64;
+const int HAZARDS_PER_THREAD = 3;   // prev, curr, next
+const int RETIRE_SCAN_THRESHOLD = 2 * CONCURRENT_MAX_THREADS * HAZARDS_PER_THREAD;
+
+struct ConcurrentNode {
+    int data;
+    atomic<uintptr_t> next; // Low bit set = node is logically deleted
+
+    ConcurrentNode(int val) : data(val), next(0) {}
+};
+
+inline bool isMarked(uintptr_t link) { return (link & 1) != 0; }
+inline ConcurrentNode* linkPointer(uintptr_t link) { return (ConcurrentNode*)(link & ~(uintptr_t)1); }
+
+struct HazardRecord {
+    atomic<ConcurrentNode*> hazards[HAZARDS_PER_THREAD];
+    atomic<bool> inUse;
+    vector<ConcurrentNode*> retired; // Only touched by the owning thread
+
+    HazardRecord() : inUse(false) {
+        for (int i = 0; i < HAZARDS_PER_THREAD; ++i) hazards[i].store(nullptr);
+    }
+};
+
+struct ConcurrentList {
+    ConcurrentNode sentinel;              // Never deleted; sentinel.next is the first node
+    HazardRecord records[CONCURRENT_MAX_THREADS];
+
+    ConcurrentList() : sentinel(0) {}
+};
+
+// Position found by concurrentFind: prevLink points at the link that holds curr
+struct ConcurrentCursor {
+    atomic<uintptr_t>* prevLink;
+    ConcurrentNode* curr;
+    ConcurrentNode* next;
+};
+
+int concurrentAcquireSlot(ConcurrentList& list) {
+    for (int i = 0; i < CONCURRENT_MAX_THREADS; ++i) {
+        bool expected = false;
+        if (list.records[i].inUse.compare_exchange_strong(expected, true)) {
+            return i;
+        }
+    }
+    return -1; // More than CONCURRENT_MAX_THREADS threads at once
+}
+
+void concurrentReleaseSlot(ConcurrentList& list, int slot) {
+    for (int i = 0; i < HAZARDS_PER_THREAD; ++i) {
+        list.records[slot].hazards[i].store(nullptr);
+    }
+    // Retired nodes stay with the record; the next owner (or the destructor) frees them
+    list.records[slot].inUse.store(false);
+}
+
+// Frees every retired node of this slot that no hazard pointer protects
+void concurrentScanRetired(ConcurrentList& list, int slot) {
+    vector<ConcurrentNode*> protectedNodes;
+    for (int t = 0; t < CONCURRENT_MAX_THREADS; ++t) {
+        for (int h = 0; h < HAZARDS_PER_THREAD; ++h) {
+            ConcurrentNode* p = list.records[t].hazards[h].load();
+            if (p != nullptr) protectedNodes.push_back(p);
+        }
+    }
+    vector<ConcurrentNode*>& retired = list.records[slot].retired;
+    size_t kept = 0;
+    for (size_t i = 0; i < retired.size(); ++i) {
+        bool isProtected = false;
+        for (ConcurrentNode* p : protectedNodes) {
+            if (p == retired[i]) {
+                isProtected = true;
+                break;
+            }
+        }
+        if (isProtected) retired[kept++] = retired[i];
+        else delete retired[i];
+    }
+    retired.resize(kept);
+}
+
+void concurrentRetire(ConcurrentList& list, int slot, ConcurrentNode* node) {
+    list.records[slot].retired.push_back(node);
+    if ((int)list.records[slot].retired.size() >= RETIRE_SCAN_THRESHOLD) {
+        concurrentScanRetired(list, slot);
+    }
+}
+
+// Finds the first unmarked node holding key, unlinking marked nodes on the way.
+// On success curr and next stay protected by this slot's hazard pointers.
+bool concurrentFind(ConcurrentList& list, int slot, int key, ConcurrentCursor& cursor) {
+    atomic<ConcurrentNode*>* hp = list.records[slot].hazards; // [0]=prev, [1]=curr, [2]=next
+tryAgain:
+    atomic<uintptr_t>* prevLink = &list.sentinel.next;
+    ConcurrentNode* curr = linkPointer(prevLink->load());
+    while (true) {
+        if (curr == nullptr) {
+            return false;
+        }
+        hp[1].store(curr);
+        if (prevLink->load() != (uintptr_t)curr) {
+            goto tryAgain; // prev was marked or changed before curr was protected
+        }
+        uintptr_t nextLink = curr->next.load();
+        ConcurrentNode* next = linkPointer(nextLink);
+        hp[2].store(next);
+        if (curr->next.load() != nextLink) {
+            goto tryAgain;
+        }
+
+        if (isMarked(nextLink)) {
+            // curr is logically deleted: help unlink it
+            uintptr_t expected = (uintptr_t)curr;
+            if (!prevLink->compare_exchange_strong(expected, (uintptr_t)next)) {
+                goto tryAgain;
+            }
+            concurrentRetire(list, slot, curr);
+            hp[1].store(next);
+            curr = next;
+            continue;
+        }
+        if (curr->data == key) {
+            cursor.prevLink = prevLink;
+            cursor.curr = curr;
+            cursor.next = next;
+            return true;
+        }
+        hp[0].store(curr); // Keep the node owning prevLink alive
+        prevLink = &curr->next;
+        hp[1].store(next);
+        curr = next;
+    }
+}
+
+void concurrentClearHazards(ConcurrentList& list, int slot) {
+    for (int i = 0; i < HAZARDS_PER_THREAD; ++i) {
+        list.records[slot].hazards[i].store(nullptr);
+    }
+}
+
+// (a) Insertion at the beginning
+void concurrentInsertAtBeginning(ConcurrentList& list, int value) {
+    ConcurrentNode* node = new ConcurrentNode(value);
+    uintptr_t first = list.sentinel.next.load();
+    do {
+        node->next.store(first);
+    } while (!list.sentinel.next.compare_exchange_weak(first, (uintptr_t)node));
+}
+
+// (c) Insertion after the first live node holding targetValue
+bool concurrentInsertAfter(ConcurrentList& list, int slot, int newValue, int targetValue) {
+    ConcurrentNode* node = new ConcurrentNode(newValue);
+    ConcurrentCursor cursor;
+    while (true) {
+        if (!concurrentFind(list, slot, targetValue, cursor)) {
+            concurrentClearHazards(list, slot);
+            delete node;
+            return false;
+        }
+        node->next.store((uintptr_t)cursor.next);
+        uintptr_t expected = (uintptr_t)cursor.next;
+        // Fails if the target got marked or its successor changed; search again
+        if (cursor.curr->next.compare_exchange_strong(expected, (uintptr_t)node)) {
+            concurrentClearHazards(list, slot);
+            return true;
+        }
+    }
+}
+
+// (f) Deletion of the first live node holding targetValue
+bool concurrentDeleteValue(ConcurrentList& list, int slot, int targetValue) {
+    ConcurrentCursor cursor;
+    while (true) {
+        if (!concurrentFind(list, slot, targetValue, cursor)) {
+            concurrentClearHazards(list, slot);
+            return false;
+        }
+        uintptr_t expected = (uintptr_t)cursor.next;
+        // Logical deletion: mark curr's next pointer
+        if (!cursor.curr->next.compare_exchange_strong(expected, (uintptr_t)cursor.next | 1)) {
+            continue;
+        }
+        // Physical deletion; if it fails a later traversal unlinks and retires it
+        expected = (uintptr_t)cursor.curr;
+        if (cursor.prevLink->compare_exchange_strong(expected, (uintptr_t)cursor.next)) {
+            concurrentRetire(list, slot, cursor.curr);
+        }
+        concurrentClearHazards(list, slot);
+        return true;
+    }
+}
+
+// (g) Search for a live node holding targetValue
+bool concurrentSearch(ConcurrentList& list, int slot, int targetValue) {
+    ConcurrentCursor cursor;
+    bool found = concurrentFind(list, slot, targetValue, cursor);
+    concurrentClearHazards(list, slot);
+    return found;
+}
+
+// Single-threaded helpers (call only while no other thread uses the list)
+int concurrentSize(ConcurrentList& list) {
+    int count = 0;
+    for (ConcurrentNode* n = linkPointer(list.sentinel.next.load()); n != nullptr; n = linkPointer(n->next.load())) {
+        if (!isMarked(n->next.load())) count++;
+    }
+    return count;
+}
+
+void cleanupConcurrent(ConcurrentList& list) {
+    ConcurrentNode* current = linkPointer(list.sentinel.next.load());
+    while (current != nullptr) {
+        ConcurrentNode* nextNode = linkPointer(current->next.load());
+        delete current;
+        current = nextNode;
+    }
+    list.sentinel.next.store(0);
+    for (int t = 0; t < CONCURRENT_MAX_THREADS; ++t) {
+        for (ConcurrentNode* p : list.records[t].retired) delete p;
+        list.records[t].retired.clear();
+    }
+}
+
+// ==========================================================
+// --- Concurrent List Stress Test and Throughput Benchmark ---
+// ==========================================================
+
+// Every thread inserts its own distinct values (at the beginning and after its
+// anchor value), searches for them and deletes half, while all other threads do
+// the same. Afterwards exactly the surviving values must be present, once each.
+bool runConcurrentStressTest(int threadCount, int valuesPerThread) {
+    ConcurrentList* list = new ConcurrentList();
+    atomic<int> failures(0);
+    vector<thread> workers;
+
+    for (int t = 0; t < threadCount; ++t) {
+        workers.push_back(thread([&, t]() {
+            int slot = concurrentAcquireSlot(*list);
+            if (slot == -1) {
+                // More workers than hazard slots: count it rather than use slot -1
+                failures++;
+                return;
+            }
+            int base = (t + 1) * 10000000;
+            concurrentInsertAtBeginning(*list, base); // Anchor
+            for (int i = 1; i <= valuesPerThread; ++i) {
+                if (i % 2 == 0) concurrentInsertAtBeginning(*list, base + i);
+                else if (!concurrentInsertAfter(*list, slot, base + i, base)) failures++;
+                if (!concurrentSearch(*list, slot, base + i)) failures++;
+            }
+            for (int i = 1; i <= valuesPerThread; i += 2) {
+                if (!concurrentDeleteValue(*list, slot, base + i)) failures++;
+                if (concurrentSearch(*list, slot, base + i)) failures++;
+            }
+            concurrentReleaseSlot(*list, slot);
+        }));
+    }
+    for (thread& w : workers) w.join();
+
+    // Validate the final contents single-threaded
+    int slot = concurrentAcquireSlot(*list);
+    if (slot == -1) {
+        cleanupConcurrent(*list);
+        delete list;
+        return false;
+    }
+    for (int t = 0; t < threadCount; ++t) {
+        int base = (t + 1) * 10000000;
+        if (!concurrentSearch(*list, slot, base)) failures++;
+        for (int i = 1; i <= valuesPerThread; ++i) {
+            if (concurrentSearch(*list, slot, base + i) != (i % 2 == 0)) failures++;
+        }
+    }
+    concurrentReleaseSlot(*list, slot);
+    int expectedSize = threadCount * (1 + valuesPerThread / 2);
+    if (concurrentSize(*list) != expectedSize) failures++;
+
+    cleanupConcurrent(*list);
+    delete list;
+    return failures.load() == 0;
+}
+
+void runConcurrentBenchmark() {
+    cout << "\n--- Lock-Free Concurrent List ---" << endl;
+    int maxThreads = (int)thread::hardware_concurrency();
+    if (maxThreads < 4) maxThreads = 4;
+    if (maxThreads > CONCURRENT_MAX_THREADS) maxThreads = CONCURRENT_MAX_THREADS;
+
+    bool stressPassed = true;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        stressPassed = runConcurrentStressTest(threads, 2000) && stressPassed;
+    }
+    cout << "Stress test (1-" << maxThreads << " threads): " << (stressPassed ? "PASSED" : "FAILED") << endl;
+
+    // Throughput: mixed 20% insert / 20% delete / 60% search over a small key range
+    const int opsPerThread = 100000;
+    const int keyRange = 512;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        ConcurrentList* list = new ConcurrentList();
+        for (int k = 0; k < keyRange; k += 2) concurrentInsertAtBeginning(*list, k);
+
+        vector<thread> workers;
+        auto start = chrono::steady_clock::now();
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(thread([&, t]() {
+                int slot = concurrentAcquireSlot(*list);
+                if (slot == -1) {
+                    return; // maxThreads is capped at CONCURRENT_MAX_THREADS, so not expected
+                }
+                unsigned int seed = 12345u + t * 7919u;
+                for (int i = 0; i < opsPerThread; ++i) {
+                    seed = seed * 1664525u + 1013904223u;
+                    int key = (int)((seed >> 8) % keyRange);
+                    int op = (int)((seed >> 24) % 10);
+                    if (op < 2) concurrentInsertAfter(*list, slot, key, (key + 1) % keyRange);
+                    else if (op < 4) concurrentDeleteValue(*list, slot, key);
+                    else concurrentSearch(*list, slot, key);
+                }
+                concurrentReleaseSlot(*list, slot);
+            }));
+        }
+        for (thread& w : workers) w.join();
+        auto end = chrono::steady_clock::now();
+
+        double seconds = chrono::duration<double>(end - start).count();
+        cout << "Threads: " << threads << " | " << (double)threads * opsPerThread / seconds / 1e6
+             << " M ops/s (final size " << concurrentSize(*list) << ")" << endl;
+        cleanupConcurrent(*list);
+        delete list;
+    }
+}
+
 // ==========================================================
 // --- Main Program ---
 // ==========================================================
 
 void runQ1Menu() {
-    cleanupList(headQ1); // Ensure Q1 list starts clean
-    insertAtBeginningQ1(10);
-    insertAtBeginningQ1(20);
-    insertAtEndQ1(30);
-    insertAtEndQ1(40);
-    displayListQ1();
+    clearList(listQ1); // Ensure Q1 list starts clean
+    insertAtBeginningQ1(listQ1, 10);
+    insertAtBeginningQ1(listQ1, 20);
+    insertAtEndQ1(listQ1, 30);
+    insertAtEndQ1(listQ1, 40);
+    displayListQ1(listQ1);
 
     int choice, data, target;
     bool insertAfter;
@@ -342,12 +1301,12 @@ void runQ1Menu() {
             case 1:
                 cout << "Enter data to insert at beginning: ";
                 cin >> data;
-                insertAtBeginningQ1(data);
+                insertAtBeginningQ1(listQ1, data);
                 break;
             case 2:
                 cout << "Enter data to insert at end: ";
                 cin >> data;
-                insertAtEndQ1(data);
+                insertAtEndQ1(listQ1, data);
                 break;
             case 3:
                 cout << "Enter new data to insert: ";
@@ -356,26 +1315,26 @@ void runQ1Menu() {
                 cin >> target;
                 cout << "Insert AFTER target (1) or BEFORE target (0)? ";
                 cin >> insertAfter;
-                insertInBetweenQ1(data, target, insertAfter);
+                insertInBetweenQ1(listQ1, data, target, insertAfter);
                 break;
             case 4:
-                deleteFromBeginningQ1();
+                deleteFromBeginningQ1(listQ1);
                 break;
             case 5:
-                deleteFromEndQ1();
+                deleteFromEndQ1(listQ1);
                 break;
             case 6:
                 cout << "Enter value of node to delete: ";
                 cin >> target;
-                deleteSpecificNodeQ1(target);
+                deleteSpecificNodeQ1(listQ1, target);
                 break;
             case 7:
                 cout << "Enter value of node to search: ";
                 cin >> target;
-                searchNodeQ1(target);
+                searchNodeQ1(listQ1, target);
                 break;
             case 8:
-                displayListQ1();
+                displayListQ1(listQ1);
                 break;
             case 9:
                 cout << "Exiting Q1 Menu..." << endl;
@@ -386,16 +1345,101 @@ void runQ1Menu() {
     } while (choice != 9);
 }
 
+// Q2 large-input mode: deletes every occurrence of key from n elements through the
+// pointer-chasing deleteAllOccurrences and through the selected SIMD kernel over
+// contiguous and unrolled storage, checks the results agree and reports throughput.
+void runQ2LargeInput(int n, int key) {
+    int* values = new int[n];
+    for (int i = 0; i < n; ++i) {
+        values[i] = (int)((i * 2654435761u) >> 29); // Pseudo-random 0..7, about 1/8 are key
+    }
+
+    // Path 1: Node list (current implementation)
+    Node* head = nullptr;
+    Node* tail = nullptr;
+    for (int i = 0; i < n; ++i) {
+        Node* node = allocNode(values[i]);
+        if (tail == nullptr) head = node;
+        else tail->next = node;
+        tail = node;
+    }
+    auto start = chrono::steady_clock::now();
+    int nodeCount = deleteAllOccurrences(head, key);
+    auto end = chrono::steady_clock::now();
+    double nodeSeconds = chrono::duration<double>(end - start).count();
+
+    // Path 2: contiguous array, scalar and SIMD kernels
+    int* scalarData = new int[n];
+    int* simdData = new int[n];
+    for (int i = 0; i < n; ++i) {
+        scalarData[i] = values[i];
+        simdData[i] = values[i];
+    }
+    start = chrono::steady_clock::now();
+    int scalarKept = compactOutScalar(scalarData, n, key);
+    end = chrono::steady_clock::now();
+    double scalarSeconds = chrono::duration<double>(end - start).count();
+
+    start = chrono::steady_clock::now();
+    int simdKept = compactOutInt(simdData, n, key);
+    end = chrono::steady_clock::now();
+    double simdSeconds = chrono::duration<double>(end - start).count();
+
+    // Path 3: unrolled list, SIMD kernel per block
+    UnrolledList unrolled;
+    for (int i = 0; i < n; ++i) {
+        unrolledInsertAtEnd(unrolled, values[i]);
+    }
+    start = chrono::steady_clock::now();
+    int unrolledCount = unrolledDeleteAllOccurrences(unrolled, key);
+    end = chrono::steady_clock::now();
+    double unrolledSeconds = chrono::duration<double>(end - start).count();
+
+    // Count and resulting order must match the Node list exactly
+    bool match = (n - scalarKept == nodeCount) && (n - simdKept == nodeCount) && (unrolledCount == nodeCount);
+    Node* current = head;
+    UnrolledBlock* block = unrolled.head;
+    int blockIndex = 0;
+    for (int i = 0; match && i < simdKept; ++i) {
+        while (block != nullptr && blockIndex == block->count) {
+            block = block->next;
+            blockIndex = 0;
+        }
+        if (current == nullptr || block == nullptr ||
+            current->data != simdData[i] || scalarData[i] != simdData[i] ||
+            block->values[blockIndex] != simdData[i]) {
+            match = false;
+        } else {
+            current = current->next;
+            blockIndex++;
+        }
+    }
+
+    cout << "Elements: " << n << ", key: " << key << ", deleted: " << nodeCount
+         << ", kernel: " << simdKernelName << endl;
+    cout << "  Node list (deleteAllOccurrences): " << n / nodeSeconds / 1e6 << " M elements/s" << endl;
+    cout << "  Contiguous scalar compaction:     " << n / scalarSeconds / 1e6 << " M elements/s" << endl;
+    cout << "  Contiguous " << simdKernelName << " compaction:" << "       " << n / simdSeconds / 1e6 << " M elements/s" << endl;
+    cout << "  Unrolled list " << simdKernelName << " compaction:" << "    " << n / unrolledSeconds / 1e6 << " M elements/s" << endl;
+    cout << "  Results identical: " << (match ? "Yes" : "No") << endl;
+
+    cleanupList(head);
+    cleanupUnrolled(unrolled);
+    delete[] values;
+    delete[] scalarData;
+    delete[] simdData;
+}
+
 void runQ2Demo() {
     cout << "\n--- Q2: Delete All Occurrences Demo ---" << endl;
     // Input: 1->2->1->2->1->3->1, key: 1
-    Node* head = new Node(1);
-    head->next = new Node(2);
-    head->next->next = new Node(1);
-    head->next->next->next = new Node(2);
-    head->next->next->next->next = new Node(1);
-    head->next->next->next->next->next = new Node(3);
-    head->next->next->next->next->next->next = new Node(1);
+    Node* head = allocNode(1);
+    head->next = allocNode(2);
+    head->next->next = allocNode(1);
+    head->next->next->next = allocNode(2);
+    head->next->next->next->next = allocNode(1);
+    head->next->next->next->next->next = allocNode(3);
+    head->next->next->next->next->next->next = allocNode(1);
 
     int key = 1;
     cout << "Original List: ";
@@ -410,17 +1454,24 @@ void runQ2Demo() {
     cout << "\n(Expected: 2 -> 2 -> 3 -> NULL)" << endl;
 
     cleanupList(head);
+
+    int largeCount = 0;
+    cout << "\nLarge-input mode: number of elements (0 to skip): ";
+    cin >> largeCount;
+    if (largeCount > 0) {
+        runQ2LargeInput(largeCount, key);
+    }
 }
 
 void runQ3Demo() {
     cout << "\n--- Q3: Find Middle Node Demo ---" << endl;
 
     // Odd length list
-    Node* head1 = new Node(1);
-    head1->next = new Node(2);
-    head1->next->next = new Node(3);
-    head1->next->next->next = new Node(4);
-    head1->next->next->next->next = new Node(5);
+    Node* head1 = allocNode(1);
+    head1->next = allocNode(2);
+    head1->next->next = allocNode(3);
+    head1->next->next->next = allocNode(4);
+    head1->next->next->next->next = allocNode(5);
 
     cout << "Input List (Odd length): ";
     printList(head1);
@@ -429,10 +1480,10 @@ void runQ3Demo() {
     cleanupList(head1);
 
     // Even length list
-    Node* head2 = new Node(10);
-    head2->next = new Node(20);
-    head2->next->next = new Node(30);
-    head2->next->next->next = new Node(40);
+    Node* head2 = allocNode(10);
+    head2->next = allocNode(20);
+    head2->next->next = allocNode(30);
+    head2->next->next->next = allocNode(40);
 
     cout << "\nInput List (Even length): ";
     printList(head2);
@@ -444,10 +1495,10 @@ void runQ3Demo() {
 void runQ4Demo() {
     cout << "\n--- Q4: Reverse Linked List Demo ---" << endl;
     // Input: 1->2->3->4->NULL
-    Node* head = new Node(1);
-    head->next = new Node(2);
-    head->next->next = new Node(3);
-    head->next->next->next = new Node(4);
+    Node* head = allocNode(1);
+    head->next = allocNode(2);
+    head->next->next = allocNode(3);
+    head->next->next->next = allocNode(4);
 
     cout << "Original List: ";
     printList(head);
@@ -461,8 +1512,272 @@ void runQ4Demo() {
     cleanupList(reversedHead);
 }
 
+void runUnrolledDemo() {
+    cout << "\n--- Unrolled Linked List Demo (" << UNROLLED_BLOCK_CAPACITY << " ints per block) ---" << endl;
+    UnrolledList list;
+    for (int i = 1; i <= 20; ++i) {
+        unrolledInsertAtEnd(list, i * 10);
+    }
+    unrolledInsertAtBeginning(list, 5);
+    unrolledInsertInBetween(list, 45, 40, true);   // After 40
+    unrolledInsertInBetween(list, 35, 40, false);  // Before 40
+    cout << "List: ";
+    printUnrolled(list);
+    cout << "\nSize: " << list.size << endl;
+
+    cout << "Search 45 -> position " << unrolledSearch(list, 45) << " (Expected: 7)" << endl;
+    unrolledDeleteValue(list, 5);
+    unrolledDeleteValue(list, 200);
+    cout << "After deleting 5 and 200: ";
+    printUnrolled(list);
+    cout << endl;
+    unrolledDeleteFromBeginning(list);
+    unrolledDeleteFromEnd(list);
+    cout << "After deleting from the beginning and the end: ";
+    printUnrolled(list);
+    cout << endl;
+
+    int middle = 0;
+    if (unrolledMiddle(list, middle)) {
+        cout << "Middle: " << middle << endl;
+    }
+    unrolledReverse(list);
+    cout << "Reversed: ";
+    printUnrolled(list);
+    cout << endl;
+    cleanupUnrolled(list);
+}
+
+// ==========================================================
+// --- Node Pool Benchmark (pool vs plain new/delete) ---
+// ==========================================================
+
+// Written by the benchmarks so the measured loops cannot be optimized away
+volatile long long benchmarkSink = 0;
+
+// Churn workload: build a list of 'batch' nodes at the head, then tear it down
+// node by node, repeated until 'operations' allocations have been performed.
+double benchmarkNewDelete(long long operations, int batch) {
+    auto start = chrono::steady_clock::now();
+    long long done = 0;
+    long long checksum = 0;
+    while (done < operations) {
+        Node* head = nullptr;
+        for (int i = 0; i < batch && done < operations; ++i, ++done) {
+            Node* node = new Node(i);
+            node->next = head;
+            head = node;
+        }
+        while (head != nullptr) {
+            Node* temp = head;
+            checksum += temp->data;
+            head = head->next;
+            delete temp;
+        }
+    }
+    auto end = chrono::steady_clock::now();
+    benchmarkSink = checksum; // Keep the work observable to the optimizer
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+double benchmarkPool(NodePool& pool, long long operations, int batch) {
+    auto start = chrono::steady_clock::now();
+    long long done = 0;
+    long long checksum = 0;
+    while (done < operations) {
+        Node* head = nullptr;
+        for (int i = 0; i < batch && done < operations; ++i, ++done) {
+            Node* node = poolAllocate(pool, i);
+            node->next = head;
+            head = node;
+        }
+        while (head != nullptr) {
+            Node* temp = head;
+            checksum += temp->data;
+            head = head->next;
+            poolRelease(pool, temp);
+        }
+    }
+    auto end = chrono::steady_clock::now();
+    benchmarkSink = checksum;
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void runPoolBenchmark() {
+    cout << "\n--- Node Pool Benchmark (pool vs new/delete) ---" << endl;
+    const int batch = 10000;
+    long long sizes[] = {100000LL, 1000000LL, 10000000LL};
+
+    for (long long ops : sizes) {
+        NodePool pool;
+        double plainMs = benchmarkNewDelete(ops, batch);
+        double poolMs = benchmarkPool(pool, ops, batch);
+        cout << "Operations: " << ops
+             << " | new/delete: " << plainMs << " ms"
+             << " | pool: " << poolMs << " ms"
+             << " | speedup: " << (poolMs > 0 ? plainMs / poolMs : 0) << "x" << endl;
+        cout << "  ";
+        printPoolStats(pool);
+        poolDestroy(pool);
+    }
+}
+
+// ==========================================================
+// --- Unrolled List Benchmark (scan vs one Node per int) ---
+// ==========================================================
+
+void runUnrolledBenchmark() {
+    cout << "\n--- Unrolled List Benchmark (full scans) ---" << endl;
+    int sizes[] = {1000000, 4000000};
+    const int rounds = 5;
+    const int missingKey = -1; // Never present, so every search scans the whole list
+
+    for (int n : sizes) {
+        SinglyList nodeList;
+        UnrolledList unrolled;
+        for (int i = 0; i < n; ++i) {
+            Node* node = allocNode(i);
+            if (nodeList.tail == nullptr) nodeList.head = node;
+            else nodeList.tail->next = node;
+            nodeList.tail = node;
+            nodeList.size++;
+            unrolledInsertAtEnd(unrolled, i);
+        }
+
+        auto start = chrono::steady_clock::now();
+        long long found = 0;
+        for (int r = 0; r < rounds; ++r) {
+            for (Node* current = nodeList.head; current != nullptr; current = current->next) {
+                if (current->data == missingKey) found++;
+            }
+            found += findMiddle(nodeList.head)->data;
+        }
+        auto mid = chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            found += unrolledSearch(unrolled, missingKey);
+            int middle = 0;
+            unrolledMiddle(unrolled, middle);
+            found += middle;
+        }
+        auto end = chrono::steady_clock::now();
+        benchmarkSink = found;
+
+        double nodeMs = chrono::duration<double, milli>(mid - start).count();
+        double unrolledMs = chrono::duration<double, milli>(end - mid).count();
+        double scanned = (double)n * rounds;
+        cout << "Elements: " << n
+             << " | Node list: " << nodeMs << " ms (" << nodeMs * 1e6 / scanned << " ns/elem)"
+             << " | Unrolled: " << unrolledMs << " ms (" << unrolledMs * 1e6 / scanned << " ns/elem)" << endl;
+
+        clearList(nodeList);
+        cleanupUnrolled(unrolled);
+    }
+}
+
+// ==========================================================
+// --- Iterator / Generic Algorithm Benchmark ---
+// ==========================================================
+
+// Times hand-written pointer walks against the equivalent std:: algorithms
+// running on the SLL iterators.
+void runIteratorBenchmark() {
+    cout << "\n--- Iterator vs Hand-Walk Benchmark ---" << endl;
+    const int n = 1000000;
+    const int rounds = 10;
+    const int missingKey = -1; // Never present, so every search scans the whole list
+
+    SinglyList list;
+    for (int i = 0; i < n; ++i) {
+        Node* node = allocNode(i);
+        if (list.tail == nullptr) list.head = node;
+        else list.tail->next = node;
+        list.tail = node;
+        list.size++;
+    }
+    long long sink = 0;
+
+    auto time = [&](const char* label, auto body) {
+        auto start = chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) sink += body();
+        auto end = chrono::steady_clock::now();
+        double ms = chrono::duration<double, milli>(end - start).count();
+        cout << label << ": " << ms / rounds << " ms/pass (" << ms * 1e6 / rounds / n << " ns/elem)" << endl;
+    };
+
+    time("SLL size   - hand walk      ", [&]() {
+        long long count = 0;
+        for (Node* c = list.head; c != nullptr; c = c->next) count++;
+        return count;
+    });
+    time("SLL size   - std::distance  ", [&]() { return (long long)listSize(list.head); });
+    time("SLL search - hand walk      ", [&]() {
+        long long pos = 0;
+        for (Node* c = list.head; c != nullptr && c->data != missingKey; c = c->next) pos++;
+        return pos;
+    });
+    time("SLL search - std::find      ", [&]() { return (long long)listSearch(list.head, missingKey); });
+    benchmarkSink = sink;
+
+    clearList(list);
+}
+
+// ==========================================================
+// --- Output Sink Benchmark (buffered vs per-element cout) ---
+// ==========================================================
+
+// Stream buffer that discards everything, so only formatting cost is measured
+class DiscardBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    streamsize xsputn(const char*, streamsize count) override { return count; }
+};
+
+// The original printer: several operator<< calls per element
+void printListPerElement(Node* head, ostream& out) {
+    Node* current = head;
+    while (current != nullptr) {
+        out << current->data;
+        if (current->next != nullptr) {
+            out << " -> ";
+        }
+        current = current->next;
+    }
+    out << " -> NULL";
+}
+
+void runOutputSinkBenchmark() {
+    cout << "\n--- Output Sink Benchmark (printing 1e6 nodes) ---" << endl;
+    const int n = 1000000;
+    SinglyList list;
+    for (int i = 0; i < n; ++i) {
+        Node* node = allocNode(i * 37 - 5000000);
+        if (list.tail == nullptr) list.head = node;
+        else list.tail->next = node;
+        list.tail = node;
+        list.size++;
+    }
+
+    DiscardBuffer discard;
+    ostream nullOut(&discard);
+
+    auto start = chrono::steady_clock::now();
+    printListPerElement(list.head, nullOut);
+    auto mid = chrono::steady_clock::now();
+    printList(list.head, nullOut);
+    auto mid2 = chrono::steady_clock::now();
+    dumpListBinary(list.head, nullOut);
+    auto end = chrono::steady_clock::now();
+
+    cout << "Per-element operator<<: " << chrono::duration<double, milli>(mid - start).count() << " ms" << endl;
+    cout << "Buffered sink (text):   " << chrono::duration<double, milli>(mid2 - mid).count() << " ms" << endl;
+    cout << "Buffered sink (binary): " << chrono::duration<double, milli>(end - mid2).count() << " ms" << endl;
+
+    clearList(list);
+}
+
 int main() {
     int mainChoice;
+    selectSimdKernels();
 
     do {
         cout << "\n=========================================" << endl;
@@ -472,8 +1787,14 @@ int main() {
         cout << "2. Run Q2: Delete All Occurrences Demo" << endl;
         cout << "3. Run Q3: Find Middle Node Demo" << endl;
         cout << "4. Run Q4: Reverse Linked List Demo" << endl;
-        cout << "5. Exit Program" << endl;
-        cout << "Enter your choice (1-5): ";
+        cout << "5. Show Node Pool Statistics" << endl;
+        cout << "6. Run Node Pool Benchmark" << endl;
+        cout << "7. Run Unrolled Linked List Demo and Benchmark" << endl;
+        cout << "8. Run Lock-Free Concurrent List Stress Test and Benchmark" << endl;
+        cout << "9. Run Output Sink Benchmark" << endl;
+        cout << "10. Run Iterator Benchmark" << endl;
+        cout << "11. Exit Program" << endl;
+        cout << "Enter your choice (1-11): ";
         cin >> mainChoice;
 
         switch (mainChoice) {
@@ -490,15 +1811,35 @@ int main() {
                 runQ4Demo();
                 break;
             case 5:
+                printPoolStats(nodePool);
+                break;
+            case 6:
+                runPoolBenchmark();
+                break;
+            case 7:
+                runUnrolledDemo();
+                runUnrolledBenchmark();
+                break;
+            case 8:
+                runConcurrentBenchmark();
+                break;
+            case 9:
+                runOutputSinkBenchmark();
+                break;
+            case 10:
+                runIteratorBenchmark();
+                break;
+            case 11:
                 cout << "Exiting program. Goodbye!" << endl;
                 break;
             default:
                 cout << "Invalid choice. Please try again." << endl;
         }
-    } while (mainChoice != 5);
+    } while (mainChoice != 11);
 
     // Final cleanup of Q1 list just in case
-    cleanupList(headQ1);
+    clearList(listQ1);
+    poolDestroy(nodePool);
 
     return 0;
 }
@@ -1,5 +1,10 @@
 #include <iostream>
 #include <string>
+#include <iterator>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include "OutputSink.h"
 
 using namespace std;
 
@@ -32,6 +37,91 @@ struct CLLNode {
 // Global CLL head (used for separate CLL demo/tests)
 CLLNode* headCLL = nullptr;
 
+// ==========================================================
+// --- ITERATORS (DLL bidirectional, CLL one-lap ring) ---
+// ==========================================================
+
+/**
+ * @brief STL bidirectional iterator over a DLL. The end iterator is nullptr;
+ * decrementing it walks once from the head to find the tail (the DLL keeps no tail pointer).
+ */
+struct DLLIterator {
+    using iterator_category = bidirectional_iterator_tag;
+    using value_type = char;
+    using difference_type = ptrdiff_t;
+    using pointer = char*;
+    using reference = char&;
+
+    DLLNode* node;
+    DLLNode* head;
+
+    DLLIterator(DLLNode* n = nullptr, DLLNode* h = nullptr) : node(n), head(h) {}
+    reference operator*() const { return node->data; }
+    pointer operator->() const { return &node->data; }
+    DLLIterator& operator++() { node = node->next; return *this; }
+    DLLIterator operator++(int) { DLLIterator old = *this; ++(*this); return old; }
+    DLLIterator& operator--() {
+        if (node == nullptr) {
+            node = head;
+            while (node->next != nullptr) node = node->next;
+        } else {
+            node = node->prev;
+        }
+        return *this;
+    }
+    DLLIterator operator--(int) { DLLIterator old = *this; --(*this); return old; }
+    bool operator==(const DLLIterator& other) const { return node == other.node; }
+    bool operator!=(const DLLIterator& other) const { return node != other.node; }
+};
+
+/**
+ * @brief Range wrapper so a DLL head can be used with range-for and std:: algorithms.
+ */
+struct DLLRange {
+    DLLNode* head;
+
+    DLLIterator begin() const { return DLLIterator(head, head); }
+    DLLIterator end() const { return DLLIterator(nullptr, head); }
+};
+
+/**
+ * @brief STL forward iterator over a CLL that stops after exactly one lap.
+ * 'lap' distinguishes begin (head, lap 0) from end (head, lap 1).
+ */
+struct CLLIterator {
+    using iterator_category = forward_iterator_tag;
+    using value_type = int;
+    using difference_type = ptrdiff_t;
+    using pointer = int*;
+    using reference = int&;
+
+    CLLNode* node;
+    CLLNode* head;
+    int lap;
+
+    CLLIterator(CLLNode* n = nullptr, CLLNode* h = nullptr, int l = 0) : node(n), head(h), lap(l) {}
+    reference operator*() const { return node->data; }
+    pointer operator->() const { return &node->data; }
+    CLLIterator& operator++() {
+        node = node->next;
+        if (node == head) lap++;
+        return *this;
+    }
+    CLLIterator operator++(int) { CLLIterator old = *this; ++(*this); return old; }
+    bool operator==(const CLLIterator& other) const { return node == other.node && lap == other.lap; }
+    bool operator!=(const CLLIterator& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Range wrapper for one lap of a CLL (empty when head is nullptr).
+ */
+struct CLLRange {
+    CLLNode* head;
+
+    CLLIterator begin() const { return CLLIterator(head, head, 0); }
+    CLLIterator end() const { return CLLIterator(head, head, head == nullptr ? 0 : 1); }
+};
+
 // ==========================================================
 // --- UTILITY FUNCTIONS ---
 // ==========================================================
@@ -39,20 +129,23 @@ CLLNode* headCLL = nullptr;
 /**
  * @brief Utility for DLL printing (supports both int and char data display).
  */
-void printDLL(DLLNode* head) {
+void printDLL(DLLNode* head, ostream& out = cout) {
+    OutputSink& sink = outputSink(out);
     if (head == nullptr) {
-        cout << "List is empty (NULL)";
+        sink.text("List is empty (NULL)");
+        sink.flush();
         return;
     }
     DLLNode* current = head;
     while (current != nullptr) {
-        cout << current->data;
+        sink.character(current->data);
         if (current->next != nullptr) {
-            cout << " <=> ";
+            sink.text(" <=> ", 5);
         }
         current = current->next;
     }
-    cout << " <=> NULL";
+    sink.text(" <=> NULL", 9);
+    sink.flush();
 }
 
 /**
@@ -218,16 +311,12 @@ void searchDLLNode(char targetData) {
         cout << "List is empty. Search failed." << endl;
         return;
     }
-    DLLNode* current = headDLL;
-    int position = 1;
-
-    while (current != nullptr) {
-        if (current->data == targetData) {
-            cout << "Node '" << targetData << "' found at position " << position << " (from head)." << endl;
-            return;
-        }
-        current = current->next;
-        position++;
+    DLLRange range{headDLL};
+    DLLIterator it = find(range.begin(), range.end(), targetData);
+    if (it != range.end()) {
+        int position = (int)distance(range.begin(), it) + 1;
+        cout << "Node '" << targetData << "' found at position " << position << " (from head)." << endl;
+        return;
     }
 
     cout << "Node '" << targetData << "' not found in the list." << endl;
@@ -250,19 +339,22 @@ CLLNode* createSampleCLL(const int values[], int size) {
     return head;
 }
 
-void displayCLL(CLLNode* head) {
+void displayCLL(CLLNode* head, ostream& out = cout) {
     if (head == nullptr) {
-        cout << "Circular Linked List is empty." << endl;
+        out << "Circular Linked List is empty." << endl;
         return;
     }
+    OutputSink& sink = outputSink(out);
     CLLNode* current = head;
     do {
-        cout << current->data << " ";
+        sink.integer(current->data).character(' ');
         current = current->next;
     } while (current != head);
 
     // Q2 Requirement: repeating value of head node at the end too.
-    cout << head->data << ". (Head repetition)" << endl;
+    sink.integer(head->data).text(". (Head repetition)\n");
+    sink.flush();
+    out.flush();
 }
 
 // ==========================================================
@@ -271,27 +363,14 @@ void displayCLL(CLLNode* head) {
 
 // Q3(i): Size of Doubly Linked List
 int findSizeDLL(DLLNode* head) {
-    int count = 0;
-    DLLNode* current = head;
-    while (current != nullptr) {
-        count++;
-        current = current->next;
-    }
-    return count;
+    DLLRange range{head};
+    return (int)distance(range.begin(), range.end());
 }
 
 // Q3(ii): Size of Circular Linked List
 int findSizeCLL(CLLNode* head) {
-    if (head == nullptr) {
-        return 0;
-    }
-    int count = 0;
-    CLLNode* current = head;
-    do {
-        count++;
-        current = current->next;
-    } while (current != head);
-    return count;
+    CLLRange range{head};
+    return (int)distance(range.begin(), range.end());
 }
 
 // ==========================================================
@@ -527,6 +606,78 @@ void runDemos() {
     delete loopedHead;
 }
 
+// ==========================================================
+// --- Iterator / Generic Algorithm Benchmark ---
+// ==========================================================
+
+// Written by the benchmark so the measured loops cannot be optimized away
+volatile long long benchmarkSink = 0;
+
+// Times hand-written pointer walks against the equivalent std:: algorithms
+// running on the DLL and CLL iterators.
+void runIteratorBenchmark() {
+    cout << "\n=========================================" << endl;
+    cout << "  ITERATOR vs HAND-WALK BENCHMARK" << endl;
+    cout << "=========================================" << endl;
+    const int n = 1000000;
+    const int rounds = 10;
+
+    // Build a DLL of n chars and a CLL of n ints
+    DLLNode* dllHead = new DLLNode('a');
+    DLLNode* dllTail = dllHead;
+    for (int i = 1; i < n; ++i) {
+        DLLNode* node = new DLLNode((char)('a' + i % 26));
+        node->prev = dllTail;
+        dllTail->next = node;
+        dllTail = node;
+    }
+    CLLNode* cllHead = new CLLNode(0);
+    CLLNode* cllTail = cllHead;
+    for (int i = 1; i < n; ++i) {
+        cllTail->next = new CLLNode(i);
+        cllTail = cllTail->next;
+    }
+    cllTail->next = cllHead;
+
+    DLLRange dll{dllHead};
+    CLLRange cll{cllHead};
+    long long sink = 0;
+
+    auto time = [&](const string& label, auto body) {
+        auto start = chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) sink += body();
+        auto end = chrono::steady_clock::now();
+        double ms = chrono::duration<double, milli>(end - start).count();
+        cout << label << ": " << ms / rounds << " ms/pass (" << ms * 1e6 / rounds / n << " ns/elem)" << endl;
+    };
+
+    time("DLL size   - hand walk      ", [&]() {
+        long long count = 0;
+        for (DLLNode* c = dllHead; c != nullptr; c = c->next) count++;
+        return count;
+    });
+    time("DLL size   - std::distance  ", [&]() { return (long long)distance(dll.begin(), dll.end()); });
+    time("DLL search - hand walk      ", [&]() {
+        long long pos = 0;
+        for (DLLNode* c = dllHead; c != nullptr && c->data != '#'; c = c->next) pos++;
+        return pos;
+    });
+    time("DLL search - std::find      ", [&]() { return (long long)(find(dll.begin(), dll.end(), '#') == dll.end()); });
+    time("DLL count  - std::count     ", [&]() { return (long long)count(dll.begin(), dll.end(), 'e'); });
+    time("CLL size   - findSizeCLL    ", [&]() { return (long long)findSizeCLL(cllHead); });
+    time("CLL sum    - hand walk      ", [&]() {
+        long long sum = 0;
+        CLLNode* c = cllHead;
+        do { sum += c->data; c = c->next; } while (c != cllHead);
+        return sum;
+    });
+    time("CLL sum    - std::accumulate", [&]() { return accumulate(cll.begin(), cll.end(), 0LL); });
+    benchmarkSink = sink;
+
+    cleanupDLL(dllHead);
+    cleanupCLL(cllHead);
+}
+
 int main() {
     int mainChoice;
 
@@ -537,11 +688,12 @@ int main() {
         cout << "=========================================" << endl;
         cout << "1. Run Q1: DLL Menu Operations" << endl;
         cout << "2. Run Q2, Q3, Q4, Q5 Demos" << endl;
-        cout << "3. Exit Program" << endl;
-        cout << "Enter your choice (1-3): ";
+        cout << "3. Run Iterator Benchmark" << endl;
+        cout << "4. Exit Program" << endl;
+        cout << "Enter your choice (1-4): ";
 
         if (!(cin >> mainChoice)) {
-            cout << "Invalid input. Please enter a number (1, 2, or 3)." << endl;
+            cout << "Invalid input. Please enter a number (1, 2, 3, or 4)." << endl;
             cin.clear(); // Clear the error flags
             cin.ignore(10000, '\n'); // Discard invalid input
             mainChoice = 0; // Set choice to an invalid value to force loop continuation
@@ -556,12 +708,15 @@ int main() {
                 runDemos();
                 break;
             case 3:
+                runIteratorBenchmark();
+                break;
+            case 4:
                 cout << "Exiting program. Cleaning up memory..." << endl;
                 break;
             default:
                 cout << "Invalid choice. Please try again." << endl;
         }
-    } while (mainChoice != 3);
+    } while (mainChoice != 4);
 
     // Final cleanup
     cleanupDLL(headDLL);
@@ -1,21 +1,119 @@
 #include <iostream>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <future>
+#include <string>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <climits>
+#include <cerrno>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "OutputSink.h"
 
 using namespace std;
 
+// ==========================================================
+// --- Sort Instrumentation Policies ---
+// ==========================================================
+
+// The Q1/Q2 sorts take a Stats policy as their first template parameter.
+// NoSortStats (the default) has empty hooks, so ordinary calls compile to the
+// uninstrumented code; CountingSortStats records into sortCounters. Counting
+// runs are single-threaded (the parallel merge is disabled for them).
+struct SortCounters {
+    long long comparisons;
+    long long moves;         // Element assignments; a swap counts as three
+    long long swaps;
+    int depth;
+    int maxDepth;            // Deepest recursion reached
+    long long scratchBytes;  // Auxiliary buffer bytes allocated
+
+    void reset() { *this = SortCounters(); }
+};
+
+SortCounters sortCounters = {};
+
+struct NoSortStats {
+    static constexpr bool enabled = false;
+    static void comparison() {}
+    static void moved(long long) {}
+    static void swapped() {}
+    static void enter() {}
+    static void leave() {}
+    static void scratch(size_t) {}
+};
+
+struct CountingSortStats {
+    static constexpr bool enabled = true;
+    static void comparison() { sortCounters.comparisons++; }
+    static void moved(long long count) { sortCounters.moves += count; }
+    static void swapped() {
+        sortCounters.swaps++;
+        sortCounters.moves += 3;
+    }
+    static void enter() {
+        if (++sortCounters.depth > sortCounters.maxDepth) sortCounters.maxDepth = sortCounters.depth;
+    }
+    static void leave() { sortCounters.depth--; }
+    static void scratch(size_t bytes) { sortCounters.scratchBytes += (long long)bytes; }
+};
+
+// Counts one level of recursion for as long as it is alive
+template <typename Stats>
+struct RecursionLevel {
+    RecursionLevel() { Stats::enter(); }
+    ~RecursionLevel() { Stats::leave(); }
+};
+
 // Forward declarations for array-based functions
 void printArray(const int arr[], int n, const string& title = "Array");
-void swapElements(int& a, int& b);
-void selectionSort(int arr[], int n);
-void insertionSort(int arr[], int n);
-void bubbleSort(int arr[], int n);
-void merge(int arr[], int left, int mid, int right);
-void mergeSort(int arr[], int left, int right);
-void quickSort(int arr[], int low, int high);
-void improvedSelectionSort(int arr[], int n);
+template <typename Stats = NoSortStats> void swapElements(int& a, int& b);
+template <typename Stats = NoSortStats> void selectionSort(int arr[], int n);
+template <typename Stats = NoSortStats> void insertionSort(int arr[], int n);
+template <typename Stats = NoSortStats> void bubbleSort(int arr[], int n);
+template <typename Stats = NoSortStats> void merge(int arr[], int scratch[], int left, int mid, int right);
+template <typename Stats = NoSortStats> void mergeSort(int arr[], int left, int right);
+// QUICK_CLASSIC: Lomuto partition with last-element pivot (Q1e as taught)
+// QUICK_INTRO:   introsort-grade production mode (see quickSort)
+// QUICK_BLOCK:   introsort driver with the branchless block partition
+enum QuickSortMode { QUICK_CLASSIC, QUICK_INTRO, QUICK_BLOCK };
+template <typename Stats = NoSortStats>
+void quickSort(int arr[], int low, int high, QuickSortMode mode = QUICK_CLASSIC);
+template <typename Stats = NoSortStats> void improvedSelectionSort(int arr[], int n);
+void naturalMergeSort(int arr[], int n);
+void radixSortLSD(int arr[], int n);
+void radixSortLSD11(int arr[], int n);
+void radixSortLSD16(int arr[], int n);
+void americanFlagSort(int arr[], int n);
+void parallelSampleSortAllCores(int arr[], int n);
 
 
 // Function to swap two integer elements manually
+template <typename Stats>
 void swapElements(int& a, int& b) {
+    Stats::swapped();
     int temp = a;
     a = b;
     b = temp;
@@ -23,14 +121,196 @@ void swapElements(int& a, int& b) {
 
 // Function to print the array elements
 void printArray(const int arr[], int n, const string& title) {
-    cout << title << ": [";
+    OutputSink& sink = outputSink();
+    sink.text(title).text(": [", 3);
     for (int i = 0; i < n; ++i) {
-        cout << arr[i];
+        sink.integer(arr[i]);
         if (i < n - 1) {
-            cout << ", ";
+            sink.text(", ", 2);
+        }
+    }
+    sink.text("]\n", 2);
+    sink.flush();
+    cout.flush();
+}
+
+// ==========================================================
+// --- Work-Stealing Task Pool (used by the parallel sorts) ---
+// ==========================================================
+
+// Each worker owns a deque: it pushes and pops its own tasks at the back
+// (depth-first, cache-warm) and idle workers steal from the front of other
+// deques (the oldest, largest pieces of work). A thread waiting on a
+// TaskGroup keeps executing tasks instead of blocking, so nested fork/join
+// recursion never deadlocks even with a single worker.
+class WorkStealingPool {
+private:
+    struct WorkerQueue {
+        mutex lock;
+        deque<function<void()>> tasks;
+    };
+
+    vector<unique_ptr<WorkerQueue>> queues;
+    vector<thread> workers;
+    atomic<bool> stopping;
+    atomic<int> pendingTasks;
+    atomic<unsigned int> nextQueue;
+    mutex sleepLock;
+    condition_variable wakeUp;
+
+    static int& currentWorker() {
+        static thread_local int index = -1;
+        return index;
+    }
+
+    bool popTask(function<void()>& task) {
+        int self = currentWorker();
+        int count = (int)queues.size();
+        if (self >= 0) {
+            WorkerQueue& own = *queues[self];
+            lock_guard<mutex> guard(own.lock);
+            if (!own.tasks.empty()) {
+                task = move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        int start = (self >= 0) ? self + 1 : 0;
+        for (int k = 0; k < count; ++k) {
+            WorkerQueue& victim = *queues[(start + k) % count];
+            lock_guard<mutex> guard(victim.lock);
+            if (!victim.tasks.empty()) {
+                task = move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(int index) {
+        currentWorker() = index;
+        while (!stopping.load()) {
+            if (!runPendingTask()) {
+                unique_lock<mutex> guard(sleepLock);
+                wakeUp.wait_for(guard, chrono::milliseconds(1), [this]() {
+                    return stopping.load() || pendingTasks.load() > 0;
+                });
+            }
+        }
+    }
+
+public:
+    explicit WorkStealingPool(int threadCount)
+        : stopping(false), pendingTasks(0), nextQueue(0) {
+        if (threadCount < 1) threadCount = 1;
+        for (int i = 0; i < threadCount; ++i) {
+            queues.push_back(unique_ptr<WorkerQueue>(new WorkerQueue()));
+        }
+        for (int i = 0; i < threadCount; ++i) {
+            workers.push_back(thread(&WorkStealingPool::workerLoop, this, i));
+        }
+    }
+
+    ~WorkStealingPool() {
+        stopping.store(true);
+        wakeUp.notify_all();
+        for (thread& worker : workers) worker.join();
+    }
+
+    int threadCount() const { return (int)workers.size(); }
+
+    void submit(function<void()> task) {
+        int self = currentWorker();
+        int target = (self >= 0) ? self : (int)(nextQueue.fetch_add(1) % queues.size());
+        {
+            lock_guard<mutex> guard(queues[target]->lock);
+            queues[target]->tasks.push_back(move(task));
+        }
+        pendingTasks.fetch_add(1);
+        wakeUp.notify_one();
+    }
+
+    // Runs one queued task on the calling thread; false if none was available
+    bool runPendingTask() {
+        function<void()> task;
+        if (!popTask(task)) return false;
+        pendingTasks.fetch_sub(1);
+        task();
+        return true;
+    }
+};
+
+// Counts outstanding tasks of one fork/join scope
+class TaskGroup {
+private:
+    WorkStealingPool& pool;
+    atomic<int> remaining;
+
+public:
+    explicit TaskGroup(WorkStealingPool& p) : pool(p), remaining(0) {}
+
+    void run(function<void()> task) {
+        remaining.fetch_add(1);
+        pool.submit([this, task]() {
+            task();
+            remaining.fetch_sub(1);
+        });
+    }
+
+    void wait() {
+        while (remaining.load() > 0) {
+            if (!pool.runPendingTask()) this_thread::yield();
         }
     }
-    cout << "]" << endl;
+};
+
+// Shared pool sized to the machine, created on first use
+WorkStealingPool& sortThreadPool() {
+    static WorkStealingPool pool((int)thread::hardware_concurrency());
+    return pool;
+}
+
+// ==========================================================
+// --- Generic Sort API (iterators + comparator + projection) ---
+// ==========================================================
+
+// Each comparison sort also exists as a template over random-access iterators.
+// Elements are ordered by comp(proj(a), proj(b)), so records can be sorted by a
+// member (proj = &Record::key), in reverse (comp = greater<>()) or by any
+// computed key. The int[] versions of the Q1/Q2 sorts are wrappers over these.
+
+// Projection that returns the element itself (std::identity is C++20)
+struct IdentityProjection {
+    template <typename T>
+    constexpr T&& operator()(T&& value) const noexcept { return std::forward<T>(value); }
+};
+
+// "a goes before b" predicate built from a comparator and a projection. It
+// carries the Stats policy, so helpers taking a Before can count through it.
+template <typename Comp, typename Proj, typename S = NoSortStats>
+struct ProjectedLess {
+    using Stats = S;
+    Comp comp;
+    Proj proj;
+
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const {
+        Stats::comparison();
+        return invoke(comp, invoke(proj, a), invoke(proj, b));
+    }
+};
+
+template <typename Stats = NoSortStats, typename Comp, typename Proj>
+ProjectedLess<Comp, Proj, Stats> projectedLess(Comp comp, Proj proj) {
+    return ProjectedLess<Comp, Proj, Stats>{comp, proj};
+}
+
+// iter_swap that reports the exchange to the Stats policy
+template <typename Stats, typename Iter>
+void sortSwap(Iter a, Iter b) {
+    Stats::swapped();
+    iter_swap(a, b);
 }
 
 // ==========================================================
@@ -38,229 +318,3307 @@ void printArray(const int arr[], int n, const string& title) {
 // ==========================================================
 
 // --- Q1(a): Selection Sort ---
-void selectionSort(int arr[], int n) {
-    for (int i = 0; i < n - 1; ++i) {
-        int min_idx = i;
-        // Find the minimum element in the remaining unsorted array
-        for (int j = i + 1; j < n; ++j) {
-            if (arr[j] < arr[min_idx]) {
-                min_idx = j;
+template <typename Stats = NoSortStats, typename Iter, typename Comp = less<>, typename Proj = IdentityProjection>
+void selectionSort(Iter first, Iter last, Comp comp = Comp(), Proj proj = Proj()) {
+    auto before = projectedLess<Stats>(comp, proj);
+    for (Iter i = first; last - i > 1; ++i) {
+        Iter minIt = i;
+        // Find the minimum element in the remaining unsorted range
+        for (Iter j = i + 1; j != last; ++j) {
+            if (before(*j, *minIt)) {
+                minIt = j;
             }
         }
         // Swap the found minimum element with the current element at i
-        swapElements(arr[i], arr[min_idx]);
+        sortSwap<Stats>(i, minIt);
     }
 }
 
+template <typename Stats>
+void selectionSort(int arr[], int n) {
+    selectionSort<Stats>(arr, arr + n);
+}
+
 // --- Q1(b): Insertion Sort ---
-void insertionSort(int arr[], int n) {
-    for (int i = 1; i < n; ++i) {
-        int key = arr[i];
-        int j = i - 1;
+template <typename Iter, typename Before>
+void insertionSortBy(Iter first, Iter last, Before& before) {
+    using Stats = typename Before::Stats;
+    if (first == last) return;
+    for (Iter i = first + 1; i != last; ++i) {
+        auto key = move(*i);
+        Iter j = i;
 
-        // Move elements of arr[0..i-1], that are greater than key, 
-        // to one position ahead of their current position
-        while (j >= 0 && arr[j] > key) {
-            arr[j + 1] = arr[j];
-            j = j - 1;
+        // Move elements of [first, i) that go after key one position ahead
+        while (j != first && before(key, *(j - 1))) {
+            *j = move(*(j - 1));
+            Stats::moved(1);
+            --j;
         }
-        arr[j + 1] = key;
+        *j = move(key);
+        Stats::moved(2);
     }
 }
 
+template <typename Stats = NoSortStats, typename Iter, typename Comp = less<>, typename Proj = IdentityProjection>
+void insertionSort(Iter first, Iter last, Comp comp = Comp(), Proj proj = Proj()) {
+    auto before = projectedLess<Stats>(comp, proj);
+    insertionSortBy(first, last, before);
+}
+
+template <typename Stats>
+void insertionSort(int arr[], int n) {
+    insertionSort<Stats>(arr, arr + n);
+}
+
 // --- Q1(c): Bubble Sort ---
-void bubbleSort(int arr[], int n) {
-    bool swapped;
-    for (int i = 0; i < n - 1; ++i) {
-        swapped = false;
-        for (int j = 0; j < n - 1 - i; ++j) {
+template <typename Stats = NoSortStats, typename Iter, typename Comp = less<>, typename Proj = IdentityProjection>
+void bubbleSort(Iter first, Iter last, Comp comp = Comp(), Proj proj = Proj()) {
+    auto before = projectedLess<Stats>(comp, proj);
+    for (Iter end = last; end - first > 1; --end) {
+        bool swapped = false;
+        for (Iter j = first; j + 1 != end; ++j) {
             // Compare adjacent elements
-            if (arr[j] > arr[j + 1]) {
-                swapElements(arr[j], arr[j + 1]);
+            if (before(*(j + 1), *j)) {
+                sortSwap<Stats>(j, j + 1);
                 swapped = true;
             }
         }
-        // If no two elements were swapped by inner loop, then array is sorted
-        if (swapped == false)
+        // If no two elements were swapped by inner loop, then the range is sorted
+        if (!swapped)
             break;
     }
 }
 
+template <typename Stats>
+void bubbleSort(int arr[], int n) {
+    bubbleSort<Stats>(arr, arr + n);
+}
+
 // --- Q1(d): Merge Sort Helper (Merge) ---
-// Merges two subarrays of arr[]. First subarray is arr[left..mid]. Second subarray is arr[mid+1..right].
-void merge(int arr[], int left, int mid, int right) {
+// Merges two sorted subarrays of arr[]: arr[left..mid] and arr[mid+1..right].
+// Only the left run is copied out (into scratch[left..mid]); the right run is read
+// in place, which is safe because the write index never passes the right read index.
+// Taking from the left run on ties keeps the sort stable.
+template <typename Stats>
+void merge(int arr[], int scratch[], int left, int mid, int right) {
     int n1 = mid - left + 1;
-    int n2 = right - mid;
+    memcpy(scratch + left, arr + left, n1 * sizeof(int));
+    Stats::moved(n1);
 
-    // Create temporary C-style arrays
-    int L[n1];
-    int R[n2];
+    int i = left;
+    int j = mid + 1;
+    int k = left;
 
-    // Copy data to temp arrays L[] and R[]
-    for (int i = 0; i < n1; i++)
-        L[i] = arr[left + i];
-    for (int j = 0; j < n2; j++)
-        R[j] = arr[mid + 1 + j];
+    while (i <= mid && j <= right) {
+        Stats::comparison();
+        Stats::moved(1);
+        if (scratch[i] <= arr[j]) {
+            arr[k++] = scratch[i++];
+        } else {
+            arr[k++] = arr[j++];
+        }
+    }
 
-    // Merge the temp arrays back into arr[left..right]
-    int i = 0; 
-    int j = 0; 
-    int k = left; 
+    // Copy the remaining elements of the left run, if any (the right run is already in place)
+    Stats::moved(mid - i + 1);
+    while (i <= mid) {
+        arr[k++] = scratch[i++];
+    }
+}
 
-    while (i < n1 && j < n2) {
-        if (L[i] <= R[j]) {
-            arr[k] = L[i];
-            i++;
-        } else {
-            arr[k] = R[j];
-            j++;
+// Below this size a subarray is finished with insertion sort instead of recursing
+const int MERGE_INSERTION_CUTOFF = 32;
+// Subarrays at least this large sort their halves as parallel tasks
+const int MERGE_PARALLEL_GRAIN = 1 << 16;
+
+// Insertion sort of arr[left..right] (stable base case for merge sort)
+template <typename Stats = NoSortStats>
+void insertionSortRange(int arr[], int left, int right) {
+    for (int i = left + 1; i <= right; ++i) {
+        int key = arr[i];
+        int j = i - 1;
+        while (j >= left && (Stats::comparison(), arr[j] > key)) {
+            arr[j + 1] = arr[j];
+            Stats::moved(1);
+            j--;
+        }
+        arr[j + 1] = key;
+        Stats::moved(2);
+    }
+}
+
+// --- Sorting-network leaf kernels (AVX2 / SSE4.1) ---
+// Small runs (8/16/32/64 ints) are sorted entirely in vector registers with a
+// bitonic network: each register is sorted in place by compare-exchange steps
+// (permute + min/max + blend), then sorted registers are combined with
+// vectorized bitonic merges. Shorter runs are padded with INT_MAX. The AVX2
+// path uses 8-lane registers, the SSE4.1 fallback 4-lane ones, and plain
+// insertion sort is used when neither instruction set is available.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SORT_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+const int NETWORK_MAX_SIZE = 64;
+
+#ifdef SORT_HAVE_X86_SIMD
+
+#define AVX2_FN __attribute__((target("avx2")))
+#define SSE4_FN __attribute__((target("sse4.1")))
+
+// One compare-exchange step: lane i is paired with lane perm[i]; lanes set in
+// maxLanes keep the larger value, the others the smaller one.
+AVX2_FN inline __m256i avx2Step(__m256i v, __m256i perm, __m256i maxLanes) {
+    __m256i w = _mm256_permutevar8x32_epi32(v, perm);
+    return _mm256_blendv_epi8(_mm256_min_epi32(v, w), _mm256_max_epi32(v, w), maxLanes);
+}
+
+// Sorts the 8 lanes of one register (bitonic sort, 6 steps)
+AVX2_FN inline __m256i avx2Sort8(__m256i v) {
+    const __m256i xor1 = _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6);
+    const __m256i xor2 = _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5);
+    const __m256i xor3 = _mm256_setr_epi32(3, 2, 1, 0, 7, 6, 5, 4);
+    const __m256i xor7 = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i max1 = _mm256_setr_epi32(0, -1, 0, -1, 0, -1, 0, -1);
+    const __m256i max2 = _mm256_setr_epi32(0, 0, -1, -1, 0, 0, -1, -1);
+    const __m256i max4 = _mm256_setr_epi32(0, 0, 0, 0, -1, -1, -1, -1);
+    v = avx2Step(v, xor1, max1);
+    v = avx2Step(v, xor3, max2);
+    v = avx2Step(v, xor1, max1);
+    v = avx2Step(v, xor7, max4);
+    v = avx2Step(v, xor2, max2);
+    v = avx2Step(v, xor1, max1);
+    return v;
+}
+
+// Sorts a bitonic register (half-cleaners at distance 4, 2, 1)
+AVX2_FN inline __m256i avx2Clean8(__m256i v) {
+    const __m256i xor1 = _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6);
+    const __m256i xor2 = _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5);
+    const __m256i xor4 = _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3);
+    const __m256i max1 = _mm256_setr_epi32(0, -1, 0, -1, 0, -1, 0, -1);
+    const __m256i max2 = _mm256_setr_epi32(0, 0, -1, -1, 0, 0, -1, -1);
+    const __m256i max4 = _mm256_setr_epi32(0, 0, 0, 0, -1, -1, -1, -1);
+    v = avx2Step(v, xor4, max4);
+    v = avx2Step(v, xor2, max2);
+    v = avx2Step(v, xor1, max1);
+    return v;
+}
+
+AVX2_FN inline __m256i avx2Reverse(__m256i v) {
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+// Vectorized bitonic merge of two sorted registers into (low, high)
+AVX2_FN inline void avx2BitonicMerge(__m256i a, __m256i b, __m256i& low, __m256i& high) {
+    b = avx2Reverse(b);
+    low = avx2Clean8(_mm256_min_epi32(a, b));
+    high = avx2Clean8(_mm256_max_epi32(a, b));
+}
+
+// Merges two sorted 8-int arrays into 16 sorted ints in 'out'
+AVX2_FN void avx2Merge8x8(const int* a, const int* b, int* out) {
+    __m256i low, high;
+    avx2BitonicMerge(_mm256_loadu_si256((const __m256i*)a), _mm256_loadu_si256((const __m256i*)b), low, high);
+    _mm256_storeu_si256((__m256i*)out, low);
+    _mm256_storeu_si256((__m256i*)(out + 8), high);
+}
+
+// Bitonic merge of two sorted runs of m registers each (v[0..m-1], v[m..2m-1])
+AVX2_FN void avx2MergeRuns(__m256i* v, int m) {
+    if (m == 1) {
+        // 8 + 8: the register-pair merge, the first stage of every network above 8
+        avx2BitonicMerge(v[0], v[1], v[0], v[1]);
+        return;
+    }
+    // Reversing the second run makes A + reverse(B) bitonic; the element-wise
+    // min/max split it into the m smallest and m largest registers.
+    __m256i low[NETWORK_MAX_SIZE / 8];
+    __m256i high[NETWORK_MAX_SIZE / 8];
+    for (int i = 0; i < m; ++i) {
+        __m256i b = avx2Reverse(v[2 * m - 1 - i]);
+        low[i] = _mm256_min_epi32(v[i], b);
+        high[i] = _mm256_max_epi32(v[i], b);
+    }
+    // Both halves are bitonic: clean across registers, then inside each one
+    for (int d = m / 2; d >= 1; d /= 2) {
+        for (int i = 0; i < m; ++i) {
+            if ((i & d) == 0) {
+                __m256i a = low[i], b = low[i + d];
+                low[i] = _mm256_min_epi32(a, b);
+                low[i + d] = _mm256_max_epi32(a, b);
+                a = high[i];
+                b = high[i + d];
+                high[i] = _mm256_min_epi32(a, b);
+                high[i + d] = _mm256_max_epi32(a, b);
+            }
+        }
+    }
+    for (int i = 0; i < m; ++i) {
+        v[i] = avx2Clean8(low[i]);
+        v[m + i] = avx2Clean8(high[i]);
+    }
+}
+
+// Sorts 'size' ints (8, 16, 32 or 64) in place
+AVX2_FN void avx2NetworkSort(int* data, int size) {
+    __m256i v[NETWORK_MAX_SIZE / 8];
+    int regs = size / 8;
+    for (int r = 0; r < regs; ++r) {
+        v[r] = avx2Sort8(_mm256_loadu_si256((const __m256i*)(data + 8 * r)));
+    }
+    for (int run = 1; run < regs; run *= 2) {
+        for (int base = 0; base < regs; base += 2 * run) {
+            avx2MergeRuns(v + base, run);
+        }
+    }
+    for (int r = 0; r < regs; ++r) {
+        _mm256_storeu_si256((__m256i*)(data + 8 * r), v[r]);
+    }
+}
+
+// SSE4.1 fallback: same network on 4-lane registers
+SSE4_FN inline __m128i sseStep(__m128i v, __m128i shuffle, __m128i maxLanes) {
+    __m128i w = _mm_shuffle_epi8(v, shuffle);
+    return _mm_blendv_epi8(_mm_min_epi32(v, w), _mm_max_epi32(v, w), maxLanes);
+}
+
+SSE4_FN inline __m128i sseLanes(int a, int b, int c, int d) {
+    // Byte shuffle that moves 32-bit lanes (a, b, c, d) into lanes 0..3
+    return _mm_setr_epi8(4 * a, 4 * a + 1, 4 * a + 2, 4 * a + 3, 4 * b, 4 * b + 1, 4 * b + 2, 4 * b + 3,
+                         4 * c, 4 * c + 1, 4 * c + 2, 4 * c + 3, 4 * d, 4 * d + 1, 4 * d + 2, 4 * d + 3);
+}
+
+SSE4_FN inline __m128i sseSort4(__m128i v) {
+    const __m128i max1 = _mm_setr_epi32(0, -1, 0, -1);
+    const __m128i max2 = _mm_setr_epi32(0, 0, -1, -1);
+    v = sseStep(v, sseLanes(1, 0, 3, 2), max1);
+    v = sseStep(v, sseLanes(3, 2, 1, 0), max2);
+    v = sseStep(v, sseLanes(1, 0, 3, 2), max1);
+    return v;
+}
+
+SSE4_FN inline __m128i sseClean4(__m128i v) {
+    v = sseStep(v, sseLanes(2, 3, 0, 1), _mm_setr_epi32(0, 0, -1, -1));
+    v = sseStep(v, sseLanes(1, 0, 3, 2), _mm_setr_epi32(0, -1, 0, -1));
+    return v;
+}
+
+SSE4_FN void sseMergeRuns(__m128i* v, int m) {
+    __m128i low[NETWORK_MAX_SIZE / 4];
+    __m128i high[NETWORK_MAX_SIZE / 4];
+    for (int i = 0; i < m; ++i) {
+        __m128i b = _mm_shuffle_epi32(v[2 * m - 1 - i], 0x1B); // Reverse lanes
+        low[i] = _mm_min_epi32(v[i], b);
+        high[i] = _mm_max_epi32(v[i], b);
+    }
+    for (int d = m / 2; d >= 1; d /= 2) {
+        for (int i = 0; i < m; ++i) {
+            if ((i & d) == 0) {
+                __m128i a = low[i], b = low[i + d];
+                low[i] = _mm_min_epi32(a, b);
+                low[i + d] = _mm_max_epi32(a, b);
+                a = high[i];
+                b = high[i + d];
+                high[i] = _mm_min_epi32(a, b);
+                high[i + d] = _mm_max_epi32(a, b);
+            }
+        }
+    }
+    for (int i = 0; i < m; ++i) {
+        v[i] = sseClean4(low[i]);
+        v[m + i] = sseClean4(high[i]);
+    }
+}
+
+SSE4_FN void sseNetworkSort(int* data, int size) {
+    __m128i v[NETWORK_MAX_SIZE / 4];
+    int regs = size / 4;
+    for (int r = 0; r < regs; ++r) {
+        v[r] = sseSort4(_mm_loadu_si128((const __m128i*)(data + 4 * r)));
+    }
+    for (int run = 1; run < regs; run *= 2) {
+        for (int base = 0; base < regs; base += 2 * run) {
+            sseMergeRuns(v + base, run);
         }
-        k++;
     }
+    for (int r = 0; r < regs; ++r) {
+        _mm_storeu_si128((__m128i*)(data + 4 * r), v[r]);
+    }
+}
+
+#endif
+
+// Scalar fallback with the same signature
+void scalarNetworkSort(int* data, int size) {
+    insertionSortRange(data, 0, size - 1);
+}
+
+// Runtime-selected kernel (scalar until selectNetworkKernel() runs)
+void (*networkSortKernel)(int*, int) = scalarNetworkSort;
+const char* networkKernelName = "scalar";
+
+void selectNetworkKernel() {
+#ifdef SORT_HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        networkSortKernel = avx2NetworkSort;
+        networkKernelName = "AVX2";
+    } else if (__builtin_cpu_supports("sse4.1")) {
+        networkSortKernel = sseNetworkSort;
+        networkKernelName = "SSE4.1";
+    }
+#endif
+}
+
+// Sorts arr[left..right] (at most NETWORK_MAX_SIZE elements) with the network
+// kernel, padding up to the next kernel size (8/16/32/64) with INT_MAX.
+void networkSortRange(int arr[], int left, int right) {
+    int n = right - left + 1;
+    if (n < 2) return;
+    int size = 8;
+    while (size < n) size *= 2;
+    int buffer[NETWORK_MAX_SIZE];
+    memcpy(buffer, arr + left, n * sizeof(int));
+    for (int i = n; i < size; ++i) buffer[i] = 2147483647;
+    networkSortKernel(buffer, size);
+    memcpy(arr + left, buffer, n * sizeof(int));
+}
+
+// Leaf sorter used by mergeSort and the introsort / block quickSort modes
+enum LeafSortMode { LEAF_INSERTION, LEAF_NETWORK };
+LeafSortMode sortLeafMode = LEAF_INSERTION;
+
+// (Counting instantiations always use insertion sort, whose steps are observable.)
+template <typename Stats = NoSortStats>
+void sortLeaf(int arr[], int left, int right) {
+    if (!Stats::enabled && sortLeafMode == LEAF_NETWORK && right - left + 1 <= NETWORK_MAX_SIZE) {
+        networkSortRange(arr, left, right);
+    } else {
+        insertionSortRange<Stats>(arr, left, right);
+    }
+}
+
+template <typename Stats = NoSortStats>
+void mergeSortRange(int arr[], int scratch[], int left, int right, WorkStealingPool* pool) {
+    RecursionLevel<Stats> level;
+    if (right - left + 1 <= MERGE_INSERTION_CUTOFF) {
+        sortLeaf<Stats>(arr, left, right);
+        return;
+    }
+    int mid = left + (right - left) / 2;
 
-    // Copy the remaining elements of L[], if any
-    while (i < n1) {
-        arr[k] = L[i];
-        i++;
-        k++;
+    if (pool != nullptr && right - left + 1 >= MERGE_PARALLEL_GRAIN) {
+        // Left half becomes a stealable task, right half runs on this thread
+        TaskGroup group(*pool);
+        group.run([=]() { mergeSortRange<Stats>(arr, scratch, left, mid, pool); });
+        mergeSortRange<Stats>(arr, scratch, mid + 1, right, pool);
+        group.wait();
+    } else {
+        mergeSortRange<Stats>(arr, scratch, left, mid, pool);
+        mergeSortRange<Stats>(arr, scratch, mid + 1, right, pool);
     }
 
-    // Copy the remaining elements of R[], if any
-    while (j < n2) {
-        arr[k] = R[j];
-        j++;
-        k++;
+    // Halves already in order (common for presorted input): nothing to merge
+    Stats::comparison();
+    if (arr[mid] <= arr[mid + 1]) {
+        return;
     }
+    merge<Stats>(arr, scratch, left, mid, right);
 }
 
 // --- Q1(d): Merge Sort Main Function ---
+// Allocates one scratch buffer for the whole sort and uses the shared
+// work-stealing pool once the input is large enough to benefit.
+template <typename Stats>
 void mergeSort(int arr[], int left, int right) {
     if (left >= right) {
         return; // Base case: array size 1 or less
     }
-    int mid = left + (right - left) / 2;
-    // Sort first and second halves
-    mergeSort(arr, left, mid);
-    mergeSort(arr, mid + 1, right);
-    // Merge the sorted halves
-    merge(arr, left, mid, right);
+    int n = right - left + 1;
+    // Sorted as the zero-based range arr[left..right] -> base[0..n-1], so the
+    // scratch buffer is sized by n however far into arr the subrange starts
+    int* base = arr + left;
+    int* scratch = new int[n];
+    Stats::scratch((size_t)n * sizeof(int));
+    WorkStealingPool* pool = (!Stats::enabled && n >= MERGE_PARALLEL_GRAIN && thread::hardware_concurrency() > 1)
+                                 ? &sortThreadPool() : nullptr;
+    mergeSortRange<Stats>(base, scratch, 0, n - 1, pool);
+    delete[] scratch;
+}
+
+// --- Q1(d): Generic Merge Sort (stable, any random-access range) ---
+// Same scheme as the int version on the half-open range [left, right): an
+// insertion-sort cutoff, no merge when the halves are already in order, and one
+// scratch vector (reserved up front) that receives the moved-out left run.
+template <typename Iter, typename Value, typename Before>
+void mergeSortBy(Iter first, ptrdiff_t left, ptrdiff_t right, vector<Value>& scratch, Before& before) {
+    using Stats = typename Before::Stats;
+    RecursionLevel<Stats> level;
+    if (right - left <= MERGE_INSERTION_CUTOFF) {
+        insertionSortBy(first + left, first + right, before);
+        return;
+    }
+    ptrdiff_t mid = left + (right - left) / 2;
+    mergeSortBy(first, left, mid, scratch, before);
+    mergeSortBy(first, mid, right, scratch, before);
+    if (!before(*(first + mid), *(first + mid - 1))) {
+        return;
+    }
+
+    scratch.assign(make_move_iterator(first + left), make_move_iterator(first + mid));
+    Stats::moved(mid - left);
+    auto i = scratch.begin();
+    Iter j = first + mid;
+    Iter k = first + left;
+    Iter rightEnd = first + right;
+    while (i != scratch.end() && j != rightEnd) {
+        // Taking from the left run on ties keeps the sort stable
+        if (before(*j, *i)) {
+            *k++ = move(*j++);
+        } else {
+            *k++ = move(*i++);
+        }
+        Stats::moved(1);
+    }
+    Stats::moved(scratch.end() - i);
+    move(i, scratch.end(), k);
+}
+
+template <typename Stats = NoSortStats, typename Iter, typename Comp = less<>, typename Proj = IdentityProjection>
+void mergeSort(Iter first, Iter last, Comp comp = Comp(), Proj proj = Proj()) {
+    using Value = typename iterator_traits<Iter>::value_type;
+    auto before = projectedLess<Stats>(comp, proj);
+    vector<Value> scratch;
+    scratch.reserve((size_t)(last - first) / 2 + 1);
+    Stats::scratch(scratch.capacity() * sizeof(Value));
+    mergeSortBy(first, (ptrdiff_t)0, (ptrdiff_t)(last - first), scratch, before);
 }
 
 // --- Q1(e): Quick Sort Helper (Partition) ---
+template <typename Stats = NoSortStats>
 int partition(int arr[], int low, int high) {
     int pivot = arr[high]; // Pivot is the last element
     int i = (low - 1); // Index of smaller element
 
     for (int j = low; j <= high - 1; j++) {
         // If current element is smaller than the pivot
+        Stats::comparison();
         if (arr[j] < pivot) {
             i++; // Increment index of smaller element
-            swapElements(arr[i], arr[j]);
+            swapElements<Stats>(arr[i], arr[j]);
         }
     }
-    swapElements(arr[i + 1], arr[high]);
+    swapElements<Stats>(arr[i + 1], arr[high]);
     return (i + 1);
 }
 
-// --- Q1(e): Quick Sort Main Function ---
-void quickSort(int arr[], int low, int high) {
-    if (low < high) {
-        // pi is partitioning index, arr[pi] is now at right place
-        int pi = partition(arr, low, high);
+// --- Q1(e): Introsort helpers ---
+const int QUICK_INSERTION_CUTOFF = 24;
+const int NINTHER_THRESHOLD = 128;
 
-        // Separately sort elements before partition and after partition
-        quickSort(arr, low, pi - 1);
-        quickSort(arr, pi + 1, high);
+// Index of the median of arr[a], arr[b], arr[c]
+int medianOfThree(const int arr[], int a, int b, int c) {
+    if (arr[a] < arr[b]) {
+        if (arr[b] < arr[c]) return b;
+        return (arr[a] < arr[c]) ? c : a;
     }
+    if (arr[a] < arr[c]) return a;
+    return (arr[b] < arr[c]) ? c : b;
 }
 
+// Median of three for small ranges, Tukey's ninther (median of three medians) for large ones
+int choosePivotIndex(const int arr[], int low, int high) {
+    int n = high - low + 1;
+    int mid = low + n / 2;
+    if (n < NINTHER_THRESHOLD) {
+        return medianOfThree(arr, low, mid, high);
+    }
+    int step = n / 8;
+    int m1 = medianOfThree(arr, low, low + step, low + 2 * step);
+    int m2 = medianOfThree(arr, mid - step, mid, mid + step);
+    int m3 = medianOfThree(arr, high - 2 * step, high - step, high);
+    return medianOfThree(arr, m1, m2, m3);
+}
 
-// ==========================================================
-// --- Q2: Improved Bidirectional Selection Sort ---
-// ==========================================================
+// Dutch national flag partition around 'pivot'. Afterwards:
+// arr[low..lt-1] < pivot, arr[lt..gt] == pivot, arr[gt+1..high] > pivot.
+void partitionThreeWay(int arr[], int low, int high, int pivot, int& lt, int& gt) {
+    lt = low;
+    gt = high;
+    int i = low;
+    while (i <= gt) {
+        if (arr[i] < pivot) {
+            swapElements(arr[lt++], arr[i++]);
+        } else if (arr[i] > pivot) {
+            swapElements(arr[i], arr[gt--]);
+        } else {
+            i++;
+        }
+    }
+}
 
-// Finds both minimum and maximum in one pass and swaps them to the correct 
-// boundary positions (i and j) of the unsorted subarray.
-void improvedSelectionSort(int arr[], int n) {
-    // i starts from the beginning (for min), j starts from the end (for max)
-    for (int i = 0, j = n - 1; i < j; ++i, --j) {
-        int min_idx = i;
-        int max_idx = i;
-        
-        // Find min and max indices in the unsorted subarray arr[i...j]
-        for (int k = i + 1; k <= j; ++k) {
-            if (arr[k] < arr[min_idx]) {
-                min_idx = k;
+// In-place heapsort of arr[low..high] (the introsort worst-case fallback)
+void siftDownRange(int arr[], int low, int root, int size) {
+    while (true) {
+        int largest = root;
+        int l = 2 * root + 1;
+        int r = l + 1;
+        if (l < size && arr[low + l] > arr[low + largest]) largest = l;
+        if (r < size && arr[low + r] > arr[low + largest]) largest = r;
+        if (largest == root) return;
+        swapElements(arr[low + root], arr[low + largest]);
+        root = largest;
+    }
+}
+
+void heapSortRange(int arr[], int low, int high) {
+    int size = high - low + 1;
+    for (int i = size / 2 - 1; i >= 0; --i) {
+        siftDownRange(arr, low, i, size);
+    }
+    for (int end = size - 1; end > 0; --end) {
+        swapElements(arr[low], arr[low + end]);
+        siftDownRange(arr, low, 0, end);
+    }
+}
+
+void introSortLoop(int arr[], int low, int high, int depthLimit) {
+    while (high - low + 1 > QUICK_INSERTION_CUTOFF) {
+        if (depthLimit == 0) {
+            heapSortRange(arr, low, high);
+            return;
+        }
+        depthLimit--;
+
+        int pivot = arr[choosePivotIndex(arr, low, high)];
+        int lt, gt;
+        partitionThreeWay(arr, low, high, pivot, lt, gt);
+
+        // Recurse into the smaller side, loop on the larger one: O(log n) stack
+        if (lt - low < high - gt) {
+            introSortLoop(arr, low, lt - 1, depthLimit);
+            low = gt + 1;
+        } else {
+            introSortLoop(arr, gt + 1, high, depthLimit);
+            high = lt - 1;
+        }
+    }
+    sortLeaf(arr, low, high);
+}
+
+void introSort(int arr[], int low, int high) {
+    if (low >= high) return;
+    int depthLimit = 0;
+    for (int n = high - low + 1; n > 1; n >>= 1) {
+        depthLimit += 2; // 2 * floor(log2(n))
+    }
+    introSortLoop(arr, low, high, depthLimit);
+}
+
+// --- Q1(e): Block (branchless) partition, BlockQuicksort / pdqsort style ---
+const int PARTITION_BLOCK_SIZE = 64;
+
+// Partitions arr[low..high] around arr[low] (the pivot, already chosen by the
+// caller). Instead of a compare-and-swap loop whose branch depends on the data,
+// it scans a block from each end and records the offsets of misplaced elements
+// with branch-free increments (num += condition), then swaps them pairwise.
+// Afterwards arr[low..p-1] < pivot <= arr[p+1..high]; returns p.
+int blockPartition(int arr[], int low, int high) {
+    int pivot = arr[low];
+    int first = low;
+    int last = high + 1;
+
+    // Skip the prefix that is already on the correct side
+    while (++first <= high && arr[first] < pivot) {}
+    do {
+        --last;
+    } while (last > first && !(arr[last] < pivot));
+
+    if (first < last) {
+        swapElements(arr[first], arr[last]);
+        ++first;
+
+        unsigned char offsetsL[PARTITION_BLOCK_SIZE];
+        unsigned char offsetsR[PARTITION_BLOCK_SIZE];
+        int baseL = first;  // offsetsL are relative to baseL (forwards)
+        int baseR = last;   // offsetsR are relative to baseR (backwards)
+        int numL = 0, numR = 0, startL = 0, startR = 0;
+
+        // Unknown region is [first, last)
+        while (first < last) {
+            int numUnknown = last - first;
+            int leftSplit = (numL == 0) ? ((numR == 0) ? numUnknown / 2 : numUnknown) : 0;
+            int rightSplit = (numR == 0) ? (numUnknown - leftSplit) : 0;
+            if (leftSplit > PARTITION_BLOCK_SIZE) leftSplit = PARTITION_BLOCK_SIZE;
+            if (rightSplit > PARTITION_BLOCK_SIZE) rightSplit = PARTITION_BLOCK_SIZE;
+
+            for (int i = 0; i < leftSplit; ++i) {
+                offsetsL[numL] = (unsigned char)i;
+                numL += !(arr[first] < pivot);
+                ++first;
+            }
+            for (int i = 0; i < rightSplit;) {
+                offsetsR[numR] = (unsigned char)++i;
+                numR += (arr[--last] < pivot);
+            }
+
+            int num = (numL < numR) ? numL : numR;
+            for (int k = 0; k < num; ++k) {
+                swapElements(arr[baseL + offsetsL[startL + k]], arr[baseR - offsetsR[startR + k]]);
             }
-            if (arr[k] > arr[max_idx]) {
-                max_idx = k;
+            numL -= num;
+            numR -= num;
+            startL += num;
+            startR += num;
+            if (numL == 0) {
+                startL = 0;
+                baseL = first;
+            }
+            if (numR == 0) {
+                startR = 0;
+                baseR = last;
             }
         }
 
-        // 1. Swap the found minimum (at min_idx) with the element at the left boundary 'i'
-        if (min_idx != i) {
-            swapElements(arr[i], arr[min_idx]);
+        // Leftover offsets from one side: move them across the boundary
+        while (numL > 0) {
+            numL--;
+            swapElements(arr[baseL + offsetsL[startL + numL]], arr[--last]);
+            first = last;
+        }
+        while (numR > 0) {
+            numR--;
+            swapElements(arr[baseR - offsetsR[startR + numR]], arr[first]);
+            ++first;
+            last = first;
         }
+    }
 
-        // 2. IMPORTANT: If the original maximum element was at 'i' (max_idx == i), 
-        // it was just moved to 'min_idx' by the swap in step 1. We must update max_idx 
-        // to point to its new location before performing the second swap.
-        if (max_idx == i) {
-            max_idx = min_idx;
+    int pivotPos = first - 1;
+    arr[low] = arr[pivotPos];
+    arr[pivotPos] = pivot;
+    return pivotPos;
+}
+
+void blockQuickSortLoop(int arr[], int low, int high, int depthLimit, bool leftmost) {
+    while (high - low + 1 > QUICK_INSERTION_CUTOFF) {
+        if (depthLimit == 0) {
+            heapSortRange(arr, low, high);
+            return;
+        }
+        depthLimit--;
+
+        swapElements(arr[low], arr[choosePivotIndex(arr, low, high)]);
+        int pivot = arr[low];
+
+        // Everything here is >= arr[low - 1]. If the pivot equals it, the range is
+        // full of duplicates of that value: group them once with a 3-way pass
+        // (as pdqsort does) instead of letting the 2-way partition go quadratic.
+        if (!leftmost && arr[low - 1] == pivot) {
+            int lt, gt;
+            partitionThreeWay(arr, low, high, pivot, lt, gt);
+            low = gt + 1;
+            continue;
         }
 
-        // 3. Swap the found maximum (at max_idx) with the element at the right boundary 'j'
-        if (max_idx != j) {
-            swapElements(arr[j], arr[max_idx]);
+        int p = blockPartition(arr, low, high);
+        if (p - low < high - p) {
+            blockQuickSortLoop(arr, low, p - 1, depthLimit, leftmost);
+            low = p + 1;
+            leftmost = false;
+        } else {
+            blockQuickSortLoop(arr, p + 1, high, depthLimit, false);
+            high = p - 1;
         }
     }
+    sortLeaf(arr, low, high);
 }
 
-// ==========================================================
-// --- Main Function and Demonstration ---
-// ==========================================================
+void blockQuickSort(int arr[], int low, int high) {
+    if (low >= high) return;
+    int depthLimit = 0;
+    for (int n = high - low + 1; n > 1; n >>= 1) {
+        depthLimit += 2;
+    }
+    blockQuickSortLoop(arr, low, high, depthLimit, true);
+}
 
-// Helper function to run the demo for Q1 sorting functions
-void runSortDemo(const string& name, void (*sortFunc)(int[], int), int arr[], int n) {
-    // Create a temporary array to hold the original data for the demo
-    int temp_arr[n];
-    for (int i = 0; i < n; ++i) {
-        temp_arr[i] = arr[i];
+// --- Q1(e): Quick Sort Main Function ---
+// QUICK_CLASSIC is the textbook Lomuto quicksort above. QUICK_INTRO is the
+// production mode: ninther / median-of-three pivots, 3-way partitioning,
+// recursion on the smaller side only, an insertion-sort cutoff and a heapsort
+// fallback once the recursion depth limit is exceeded. QUICK_BLOCK is the same
+// driver with the branchless block partition in place of the 3-way one.
+// Only the classic mode is instrumented; the others ignore Stats.
+template <typename Stats>
+void quickSort(int arr[], int low, int high, QuickSortMode mode) {
+    if (mode == QUICK_INTRO) {
+        introSort(arr, low, high);
+        return;
     }
+    if (mode == QUICK_BLOCK) {
+        blockQuickSort(arr, low, high);
+        return;
+    }
+    RecursionLevel<Stats> level;
+    if (low < high) {
+        // pi is partitioning index, arr[pi] is now at right place
+        int pi = partition<Stats>(arr, low, high);
 
-    cout << "\n--- Running " << name << " ---" << endl;
-    printArray(temp_arr, n, "Original");
-    
-    // Call the sorting function
-    // For Merge Sort and Quick Sort, we need special wrappers to call the 
-    // recursive function with the correct initial bounds (0 and n-1)
-    if (name.find("Merge") != string::npos) {
-        mergeSort(temp_arr, 0, n - 1);
-    } else if (name.find("Quick") != string::npos) {
-        quickSort(temp_arr, 0, n - 1);
-    } else {
-        sortFunc(temp_arr, n);
+        // Separately sort elements before partition and after partition
+        quickSort<Stats>(arr, low, pi - 1, mode);
+        quickSort<Stats>(arr, pi + 1, high, mode);
     }
-    
-    printArray(temp_arr, n, "Sorted");
 }
 
-int main() {
-    int test_arr[] = {64, 25, 12, 22, 11, 75, 5, 33};
-    int n = sizeof(test_arr) / sizeof(test_arr[0]);
+// --- Q1(e): Generic Quick Sort (introsort over any random-access range) ---
+// The QUICK_INTRO scheme with the comparator and projection: median-of-three /
+// ninther pivot, 3-way partition, smaller side first, heapsort fallback.
+template <typename Iter, typename Before>
+Iter medianOfThreeBy(Iter a, Iter b, Iter c, Before& before) {
+    if (before(*a, *b)) {
+        if (before(*b, *c)) return b;
+        return before(*a, *c) ? c : a;
+    }
+    if (before(*a, *c)) return a;
+    return before(*b, *c) ? c : b;
+}
 
-    cout << "=======================================================" << endl;
-    cout << "  Lab Assignment 7: Sorting Techniques (Q1)" << endl;
+template <typename Iter, typename Before>
+void introSortLoopBy(Iter first, Iter last, int depthLimit, Before& before) {
+    using Stats = typename Before::Stats;
+    RecursionLevel<Stats> level;
+    while (last - first > QUICK_INSERTION_CUTOFF) {
+        if (depthLimit == 0) {
+            make_heap(first, last, before);
+            sort_heap(first, last, before);
+            return;
+        }
+        depthLimit--;
+
+        auto n = last - first;
+        Iter mid = first + n / 2;
+        Iter pivotIt;
+        if (n < NINTHER_THRESHOLD) {
+            pivotIt = medianOfThreeBy(first, mid, last - 1, before);
+        } else {
+            auto step = n / 8;
+            pivotIt = medianOfThreeBy(medianOfThreeBy(first, first + step, first + 2 * step, before),
+                                      medianOfThreeBy(mid - step, mid, mid + step, before),
+                                      medianOfThreeBy(last - 1 - 2 * step, last - 1 - step, last - 1, before),
+                                      before);
+        }
+        auto pivot = *pivotIt;
+        Stats::moved(1);
+
+        // [first, lt) < pivot, [lt, i) == pivot, [gt, last) > pivot
+        Iter lt = first;
+        Iter gt = last;
+        Iter i = first;
+        while (i != gt) {
+            if (before(*i, pivot)) {
+                sortSwap<Stats>(lt++, i++);
+            } else if (before(pivot, *i)) {
+                sortSwap<Stats>(i, --gt);
+            } else {
+                ++i;
+            }
+        }
+
+        if (lt - first < last - gt) {
+            introSortLoopBy(first, lt, depthLimit, before);
+            first = gt;
+        } else {
+            introSortLoopBy(gt, last, depthLimit, before);
+            last = lt;
+        }
+    }
+    insertionSortBy(first, last, before);
+}
+
+template <typename Stats = NoSortStats, typename Iter, typename Comp = less<>, typename Proj = IdentityProjection>
+void quickSort(Iter first, Iter last, Comp comp = Comp(), Proj proj = Proj()) {
+    auto before = projectedLess<Stats>(comp, proj);
+    int depthLimit = 0;
+    for (auto n = last - first; n > 1; n >>= 1) {
+        depthLimit += 2;
+    }
+    introSortLoopBy(first, last, depthLimit, before);
+}
+
+
+// ==========================================================
+// --- Q2: Improved Bidirectional Selection Sort ---
+// ==========================================================
+
+// Finds both minimum and maximum in one pass and swaps them to the correct 
+// boundary positions (i and j) of the unsorted subrange.
+template <typename Stats = NoSortStats, typename Iter, typename Comp = less<>, typename Proj = IdentityProjection>
+void improvedSelectionSort(Iter first, Iter last, Comp comp = Comp(), Proj proj = Proj()) {
+    if (last - first < 2) return;
+    auto before = projectedLess<Stats>(comp, proj);
+    // i starts from the beginning (for min), j starts from the end (for max)
+    for (Iter i = first, j = last - 1; i < j; ++i, --j) {
+        Iter minIt = i;
+        Iter maxIt = i;
+
+        // Find min and max positions in the unsorted subrange [i...j]
+        for (Iter k = i + 1; k <= j; ++k) {
+            if (before(*k, *minIt)) {
+                minIt = k;
+            }
+            if (before(*maxIt, *k)) {
+                maxIt = k;
+            }
+        }
+
+        // 1. Swap the found minimum with the element at the left boundary 'i'
+        if (minIt != i) {
+            sortSwap<Stats>(i, minIt);
+        }
+
+        // 2. IMPORTANT: If the original maximum element was at 'i' (maxIt == i), 
+        // it was just moved to 'minIt' by the swap in step 1. We must update maxIt 
+        // to point to its new location before performing the second swap.
+        if (maxIt == i) {
+            maxIt = minIt;
+        }
+
+        // 3. Swap the found maximum with the element at the right boundary 'j'
+        if (maxIt != j) {
+            sortSwap<Stats>(j, maxIt);
+        }
+    }
+}
+
+template <typename Stats>
+void improvedSelectionSort(int arr[], int n) {
+    improvedSelectionSort<Stats>(arr, arr + n);
+}
+
+// ==========================================================
+// --- Selection and Top-k (nthElement, partialSort, streaming) ---
+// ==========================================================
+
+// Introselect: quickselect on the Lomuto partition above, with the ninther /
+// median-of-three pivot swapped into the last slot first. Only the side that
+// holds position k is kept. After 2*log2(n) rounds without converging (e.g.
+// many duplicates, which Lomuto splits badly) the remaining range is finished
+// with heapsort, so the worst case stays O(n log n).
+// Afterwards arr[k] holds the value a full sort would put there, everything
+// before it is <= arr[k] and everything after it is >= arr[k].
+void nthElement(int arr[], int n, int k) {
+    if (k < 0 || k >= n) return;
+    int low = 0;
+    int high = n - 1;
+    int depthLimit = 0;
+    for (int size = n; size > 1; size >>= 1) {
+        depthLimit += 2;
+    }
+    while (high - low + 1 > QUICK_INSERTION_CUTOFF) {
+        if (depthLimit-- == 0) {
+            heapSortRange(arr, low, high);
+            return;
+        }
+        swapElements(arr[choosePivotIndex(arr, low, high)], arr[high]);
+        int pi = partition(arr, low, high);
+        if (pi == k) return;
+        if (k < pi) {
+            high = pi - 1;
+        } else {
+            low = pi + 1;
+        }
+    }
+    insertionSortRange(arr, low, high);
+}
+
+// Up to n / PARTIAL_SORT_HEAP_DIVISOR the bounded heap wins; beyond that
+// selecting first and sorting only the prefix is cheaper
+const int PARTIAL_SORT_HEAP_DIVISOR = 32;
+
+// k smallest values via a bounded max-heap kept in arr[0..k-1]: each later
+// element only enters if it beats the current maximum. O(n log k).
+void partialSortHeap(int arr[], int n, int k) {
+    for (int i = k / 2 - 1; i >= 0; --i) {
+        siftDownRange(arr, 0, i, k);
+    }
+    for (int i = k; i < n; ++i) {
+        if (arr[i] < arr[0]) {
+            swapElements(arr[i], arr[0]);
+            siftDownRange(arr, 0, 0, k);
+        }
+    }
+    // Heapsort the prefix in place (ascending)
+    for (int end = k - 1; end > 0; --end) {
+        swapElements(arr[0], arr[end]);
+        siftDownRange(arr, 0, 0, end);
+    }
+}
+
+// k smallest values via introselect, then introsort of the prefix. O(n + k log k).
+void partialSortSelect(int arr[], int n, int k) {
+    if (k < n) nthElement(arr, n, k - 1);
+    introSort(arr, 0, k - 1);
+}
+
+// Rearranges arr so that arr[0..k-1] holds the k smallest values in ascending
+// order; the order of arr[k..n-1] is unspecified.
+void partialSort(int arr[], int n, int k) {
+    if (k > n) k = n;
+    if (k <= 0) return;
+    if (k <= n / PARTIAL_SORT_HEAP_DIVISOR) {
+        partialSortHeap(arr, n, k);
+    } else {
+        partialSortSelect(arr, n, k);
+    }
+}
+
+// Streaming top-k for unbounded input: keeps the k smallest values seen so far
+// in a max-heap of size k, so memory stays O(k) and each value costs O(log k).
+class StreamingTopK {
+private:
+    int k;
+    vector<int> heap;
+
+public:
+    explicit StreamingTopK(int count) : k(count) { heap.reserve(max(0, count)); }
+
+    void push(int value) {
+        if ((int)heap.size() < k) {
+            heap.push_back(value);
+            push_heap(heap.begin(), heap.end());
+        } else if (k > 0 && value < heap[0]) {
+            heap[0] = value;
+            siftDownRange(heap.data(), 0, 0, k);
+        }
+    }
+
+    void push(const int values[], int count) {
+        for (int i = 0; i < count; ++i) push(values[i]);
+    }
+
+    int size() const { return (int)heap.size(); }
+
+    // Largest of the k smallest values so far: once k values are held, a new
+    // value is kept only if it is below this. While fewer than k values have
+    // been pushed every value is kept and INT_MAX is returned; with k == 0
+    // nothing is ever kept and INT_MIN is returned.
+    int threshold() const {
+        if (k <= 0) return INT_MIN;
+        if ((int)heap.size() < k) return INT_MAX;
+        return heap[0];
+    }
+
+    // The current top k in ascending order
+    vector<int> sorted() const {
+        vector<int> result = heap;
+        sort_heap(result.begin(), result.end());
+        return result;
+    }
+};
+
+// ==========================================================
+// --- Adaptive Natural Merge Sort (powersort with galloping) ---
+// ==========================================================
+
+// Splits the input into maximal runs (strictly descending runs are reversed in
+// place), extends runs shorter than NATURAL_MIN_RUN with binary insertion and
+// merges neighbours in the order given by powersort's node powers, which keeps
+// the run stack O(log n) and the total merge cost near-optimal. Merges trim the
+// parts of both runs that are already in place, copy the smaller remainder
+// into scratch, and switch to galloping (exponential search + bulk moves) when
+// one side keeps winning. Presorted and nearly sorted inputs cost close to O(n).
+const int NATURAL_MIN_RUN = 32;
+const int NATURAL_MIN_GALLOP = 7;
+
+// First position in [first, last) whose element does not go before key (lower bound),
+// found by exponential search from the left
+template <typename Iter, typename T, typename Before>
+Iter gallopLower(Iter first, Iter last, const T& key, Before& before) {
+    ptrdiff_t n = last - first;
+    ptrdiff_t lo = 0;
+    ptrdiff_t hi = 1;
+    while (hi <= n && before(first[hi - 1], key)) {
+        lo = hi;
+        hi = 2 * hi + 1;
+    }
+    return lower_bound(first + lo, first + min(hi, n), key, before);
+}
+
+// First position in [first, last) whose element goes after key (upper bound), from the left
+template <typename Iter, typename T, typename Before>
+Iter gallopUpper(Iter first, Iter last, const T& key, Before& before) {
+    ptrdiff_t n = last - first;
+    ptrdiff_t lo = 0;
+    ptrdiff_t hi = 1;
+    while (hi <= n && !before(key, first[hi - 1])) {
+        lo = hi;
+        hi = 2 * hi + 1;
+    }
+    return upper_bound(first + lo, first + min(hi, n), key, before);
+}
+
+// Lower / upper bound found by exponential search from the right end
+template <typename Iter, typename T, typename Before>
+Iter gallopLowerFromRight(Iter first, Iter last, const T& key, Before& before) {
+    ptrdiff_t n = last - first;
+    ptrdiff_t hi = n;
+    ptrdiff_t step = 1;
+    while (step <= n && !before(first[n - step], key)) {
+        hi = n - step;
+        step = 2 * step + 1;
+    }
+    ptrdiff_t lo = (step <= n) ? n - step + 1 : 0;
+    return lower_bound(first + lo, first + hi, key, before);
+}
+
+template <typename Iter, typename T, typename Before>
+Iter gallopUpperFromRight(Iter first, Iter last, const T& key, Before& before) {
+    ptrdiff_t n = last - first;
+    ptrdiff_t hi = n;
+    ptrdiff_t step = 1;
+    while (step <= n && before(key, first[n - step])) {
+        hi = n - step;
+        step = 2 * step + 1;
+    }
+    ptrdiff_t lo = (step <= n) ? n - step + 1 : 0;
+    return upper_bound(first + lo, first + hi, key, before);
+}
+
+// Returns the end of the run starting at 'lo', reversing it if it is strictly descending
+template <typename Iter, typename Before>
+ptrdiff_t findRunAndMakeAscending(Iter first, ptrdiff_t lo, ptrdiff_t n, Before& before) {
+    ptrdiff_t end = lo + 1;
+    if (end == n) return end;
+    if (before(first[end], first[lo])) {
+        // Strictly descending, so reversing cannot reorder equal elements
+        while (end < n && before(first[end], first[end - 1])) end++;
+        reverse(first + lo, first + end);
+    } else {
+        while (end < n && !before(first[end], first[end - 1])) end++;
+    }
+    return end;
+}
+
+// Binary insertion of first[sortedEnd..hi) into the sorted prefix first[lo..sortedEnd)
+template <typename Iter, typename Before>
+void binaryInsertionSortBy(Iter first, ptrdiff_t lo, ptrdiff_t hi, ptrdiff_t sortedEnd, Before& before) {
+    using Stats = typename Before::Stats;
+    for (ptrdiff_t i = sortedEnd; i < hi; ++i) {
+        auto key = move(first[i]);
+        // upper_bound keeps equal elements in their original order
+        Iter pos = upper_bound(first + lo, first + i, key, before);
+        move_backward(pos, first + i, first + i + 1);
+        *pos = move(key);
+        Stats::moved((first + i - pos) + 2);
+    }
+}
+
+// Powersort node power of the boundary between runs [s1, s1 + n1) and
+// [s1 + n1, s1 + n1 + n2) in an input of n elements
+inline int powersortNodePower(ptrdiff_t s1, ptrdiff_t n1, ptrdiff_t n2, ptrdiff_t n) {
+    int power = 0;
+    ptrdiff_t a = 2 * s1 + n1;
+    ptrdiff_t b = a + n1 + n2;
+    while (true) {
+        ++power;
+        if (a >= n) {
+            a -= n;
+            b -= n;
+        } else if (b >= n) {
+            break;
+        }
+        a <<= 1;
+        b <<= 1;
+    }
+    return power;
+}
+
+// Merges first[a..a+lenA) with first[a+lenA..a+lenA+lenB) where the left run
+// is the shorter one: it is moved to scratch and merged from the left.
+template <typename Iter, typename Value, typename Before>
+void gallopMergeLow(Iter first, ptrdiff_t a, ptrdiff_t lenA, ptrdiff_t lenB,
+                    vector<Value>& scratch, int& minGallop, Before& before) {
+    using Stats = typename Before::Stats;
+    scratch.assign(make_move_iterator(first + a), make_move_iterator(first + a + lenA));
+    Stats::moved(lenA);
+    auto i = scratch.begin();
+    auto iEnd = scratch.end();
+    Iter j = first + a + lenA;
+    Iter jEnd = j + lenB;
+    Iter dest = first + a;
+
+    while (i != iEnd && j != jEnd) {
+        int winsA = 0;
+        int winsB = 0;
+        // One element at a time until one side wins minGallop times in a row
+        while (i != iEnd && j != jEnd) {
+            if (before(*j, *i)) {
+                *dest++ = move(*j++);
+                Stats::moved(1);
+                winsB++;
+                winsA = 0;
+                if (winsB >= minGallop) break;
+            } else {
+                *dest++ = move(*i++);
+                Stats::moved(1);
+                winsA++;
+                winsB = 0;
+                if (winsA >= minGallop) break;
+            }
+        }
+        // Galloping: move whole stretches found by exponential search
+        while (i != iEnd && j != jEnd) {
+            auto runA = gallopUpper(i, iEnd, *j, before);
+            winsA = (int)(runA - i);
+            Stats::moved(winsA);
+            dest = move(i, runA, dest);
+            i = runA;
+            if (i == iEnd) break;
+
+            Iter runB = gallopLower(j, jEnd, *i, before);
+            winsB = (int)(runB - j);
+            Stats::moved(winsB);
+            dest = move(j, runB, dest);
+            j = runB;
+            if (j == jEnd) break;
+
+            if (winsA < NATURAL_MIN_GALLOP && winsB < NATURAL_MIN_GALLOP) {
+                minGallop++; // Galloping is not paying off: make it harder to re-enter
+                break;
+            }
+            if (minGallop > 1) minGallop--;
+        }
+    }
+    // Leftover right-run elements are already in place
+    Stats::moved(iEnd - i);
+    move(i, iEnd, dest);
+}
+
+// Same merge when the right run is the shorter one: it is moved to scratch
+// and the runs are merged from the right end.
+template <typename Iter, typename Value, typename Before>
+void gallopMergeHigh(Iter first, ptrdiff_t a, ptrdiff_t lenA, ptrdiff_t lenB,
+                     vector<Value>& scratch, int& minGallop, Before& before) {
+    using Stats = typename Before::Stats;
+    scratch.assign(make_move_iterator(first + a + lenA), make_move_iterator(first + a + lenA + lenB));
+    Stats::moved(lenB);
+    Iter aBegin = first + a;
+    Iter i = aBegin + lenA;
+    auto jBegin = scratch.begin();
+    auto j = scratch.end();
+    Iter dest = first + a + lenA + lenB;
+
+    while (i != aBegin && j != jBegin) {
+        int winsA = 0;
+        int winsB = 0;
+        while (i != aBegin && j != jBegin) {
+            // On ties the right-run element goes last, which keeps the merge stable
+            if (before(*(j - 1), *(i - 1))) {
+                *--dest = move(*--i);
+                Stats::moved(1);
+                winsA++;
+                winsB = 0;
+                if (winsA >= minGallop) break;
+            } else {
+                *--dest = move(*--j);
+                Stats::moved(1);
+                winsB++;
+                winsA = 0;
+                if (winsB >= minGallop) break;
+            }
+        }
+        while (i != aBegin && j != jBegin) {
+            Iter runA = gallopUpperFromRight(aBegin, i, *(j - 1), before);
+            winsA = (int)(i - runA);
+            Stats::moved(winsA);
+            dest = move_backward(runA, i, dest);
+            i = runA;
+            if (i == aBegin) break;
+
+            auto runB = gallopLowerFromRight(jBegin, j, *(i - 1), before);
+            winsB = (int)(j - runB);
+            Stats::moved(winsB);
+            dest = move_backward(runB, j, dest);
+            j = runB;
+            if (j == jBegin) break;
+
+            if (winsA < NATURAL_MIN_GALLOP && winsB < NATURAL_MIN_GALLOP) {
+                minGallop++;
+                break;
+            }
+            if (minGallop > 1) minGallop--;
+        }
+    }
+    // Leftover left-run elements are already in place
+    Stats::moved(j - jBegin);
+    move_backward(jBegin, j, dest);
+}
+
+// Merges two adjacent sorted runs after trimming the parts already in place
+template <typename Iter, typename Value, typename Before>
+void mergeNaturalRuns(Iter first, ptrdiff_t a, ptrdiff_t lenA, ptrdiff_t lenB,
+                      vector<Value>& scratch, int& minGallop, Before& before) {
+    Iter b = first + a + lenA;
+    // Elements of A not after B's first element are already in place
+    ptrdiff_t skip = gallopUpper(first + a, b, *b, before) - (first + a);
+    a += skip;
+    lenA -= skip;
+    if (lenA == 0) return;
+    // Elements of B not before A's last element are already in place
+    lenB = gallopLowerFromRight(b, b + lenB, *(b - 1), before) - b;
+    if (lenB == 0) return;
+
+    if (lenA <= lenB) {
+        gallopMergeLow(first, a, lenA, lenB, scratch, minGallop, before);
+    } else {
+        gallopMergeHigh(first, a, lenA, lenB, scratch, minGallop, before);
+    }
+}
+
+template <typename Stats = NoSortStats, typename Iter, typename Comp = less<>, typename Proj = IdentityProjection>
+void naturalMergeSort(Iter first, Iter last, Comp comp = Comp(), Proj proj = Proj()) {
+    using Value = typename iterator_traits<Iter>::value_type;
+    struct Run {
+        ptrdiff_t start;
+        ptrdiff_t length;
+        int power;
+    };
+
+    ptrdiff_t n = last - first;
+    if (n < 2) return;
+    auto before = projectedLess<Stats>(comp, proj);
+    vector<Value> scratch;
+    int minGallop = NATURAL_MIN_GALLOP;
+    vector<Run> stack;
+
+    // Finds the run starting at 'start', extended to NATURAL_MIN_RUN if short
+    auto nextRun = [&](ptrdiff_t start) {
+        ptrdiff_t end = findRunAndMakeAscending(first, start, n, before);
+        if (end - start < NATURAL_MIN_RUN && end < n) {
+            ptrdiff_t forced = min(n, start + (ptrdiff_t)NATURAL_MIN_RUN);
+            binaryInsertionSortBy(first, start, forced, end, before);
+            end = forced;
+        }
+        return Run{start, end - start, 0};
+    };
+
+    Run current = nextRun(0);
+    while (current.start + current.length < n) {
+        Run next = nextRun(current.start + current.length);
+        int power = powersortNodePower(current.start, current.length, next.length, n);
+        // Merge everything on the stack that sits deeper in the powersort tree
+        while (!stack.empty() && stack.back().power > power) {
+            Run left = stack.back();
+            stack.pop_back();
+            mergeNaturalRuns(first, left.start, left.length, current.length, scratch, minGallop, before);
+            current = Run{left.start, left.length + current.length, 0};
+        }
+        current.power = power;
+        stack.push_back(current);
+        current = next;
+    }
+    while (!stack.empty()) {
+        Run left = stack.back();
+        stack.pop_back();
+        mergeNaturalRuns(first, left.start, left.length, current.length, scratch, minGallop, before);
+        current = Run{left.start, left.length + current.length, 0};
+    }
+    Stats::scratch(scratch.capacity() * sizeof(Value));
+}
+
+void naturalMergeSort(int arr[], int n) {
+    naturalMergeSort(arr, arr + n);
+}
+
+// ==========================================================
+// --- Radix Sorts (LSD and in-place MSD for integer keys) ---
+// ==========================================================
+
+// Signed keys are sorted by flipping the sign bit and treating the result as
+// unsigned, so negative numbers order before positive ones.
+template <typename T, typename = enable_if_t<is_integral_v<T>>>
+inline auto radixKey(T value) {
+    using Bits = make_unsigned_t<T>;
+    Bits bits = (Bits)value;
+    if constexpr (is_signed_v<T>) {
+        bits ^= (Bits)((Bits)1 << (sizeof(T) * 8 - 1));
+    }
+    return bits;
+}
+
+// IEEE floats: negative values have all bits flipped (larger magnitude sorts
+// first), positive values only the sign bit. -0.0 orders before +0.0.
+inline unsigned int radixKey(float value) {
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+inline unsigned long long radixKey(double value) {
+    unsigned long long bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x8000000000000000ull) ? ~bits : (bits | 0x8000000000000000ull);
+}
+
+// LSD radix sort with 'digitBits'-wide digits (8, 11 or 16). All digit
+// histograms are built in a single read pass; a pass whose digit is the same
+// for every key is skipped. One scratch buffer is ping-ponged with the input.
+template <typename Stats = NoSortStats, typename Key>
+void lsdRadixSortImpl(Key arr[], int n, int digitBits) {
+    if (n < 2) return;
+    const int keyBits = (int)sizeof(radixKey(arr[0])) * 8;
+    const int passes = (keyBits + digitBits - 1) / digitBits;
+    const int radix = 1 << digitBits;
+    const auto mask = (decltype(radixKey(arr[0])))(radix - 1);
+
+    vector<int> counts((size_t)passes * radix, 0);
+    for (int i = 0; i < n; ++i) {
+        auto key = radixKey(arr[i]);
+        for (int p = 0; p < passes; ++p) {
+            counts[(size_t)p * radix + ((key >> (p * digitBits)) & mask)]++;
+        }
+    }
+
+    Key* scratch = new Key[n];
+    Stats::scratch((size_t)n * sizeof(Key));
+    Key* from = arr;
+    Key* to = scratch;
+    for (int p = 0; p < passes; ++p) {
+        int* count = &counts[(size_t)p * radix];
+        int shift = p * digitBits;
+        // Trivial pass: every key has the same digit here
+        if (count[(radixKey(from[0]) >> shift) & mask] == n) continue;
+
+        int offset = 0;
+        for (int d = 0; d < radix; ++d) {
+            int c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        for (int i = 0; i < n; ++i) {
+            to[count[(radixKey(from[i]) >> shift) & mask]++] = from[i];
+        }
+        Stats::moved(n);
+        Key* temp = from;
+        from = to;
+        to = temp;
+    }
+    if (from != arr) {
+        memcpy(arr, from, (size_t)n * sizeof(Key));
+        Stats::moved(n);
+    }
+    delete[] scratch;
+}
+
+void radixSortLSD(int arr[], int n) { lsdRadixSortImpl(arr, n, 8); }
+void radixSortLSD11(int arr[], int n) { lsdRadixSortImpl(arr, n, 11); }
+void radixSortLSD16(int arr[], int n) { lsdRadixSortImpl(arr, n, 16); }
+void radixSortLSD64(long long arr[], int n, int digitBits = 11) { lsdRadixSortImpl(arr, n, digitBits); }
+
+// Below this bucket size the MSD sort finishes with insertion sort
+const int AMERICAN_FLAG_CUTOFF = 32;
+
+// In-place MSD radix sort (American flag sort) on 8-bit digits, most
+// significant first. Elements are permuted into their buckets by cycling
+// swaps, so no scratch buffer is needed; each bucket then recurses on the
+// next digit.
+template <typename Key>
+void americanFlagSortImpl(Key arr[], int n, int shift) {
+    if (n <= AMERICAN_FLAG_CUTOFF) {
+        for (int i = 1; i < n; ++i) {
+            Key key = arr[i];
+            int j = i - 1;
+            while (j >= 0 && arr[j] > key) {
+                arr[j + 1] = arr[j];
+                j--;
+            }
+            arr[j + 1] = key;
+        }
+        return;
+    }
+
+    int count[256] = {0};
+    for (int i = 0; i < n; ++i) {
+        count[(radixKey(arr[i]) >> shift) & 0xFF]++;
+    }
+    int next[256];
+    int end[256];
+    int offset = 0;
+    for (int d = 0; d < 256; ++d) {
+        next[d] = offset;
+        offset += count[d];
+        end[d] = offset;
+    }
+
+    for (int d = 0; d < 256; ++d) {
+        while (next[d] < end[d]) {
+            Key value = arr[next[d]];
+            int digit = (int)((radixKey(value) >> shift) & 0xFF);
+            // Follow the cycle until a value belonging to bucket d comes back
+            while (digit != d) {
+                Key displaced = arr[next[digit]];
+                arr[next[digit]++] = value;
+                value = displaced;
+                digit = (int)((radixKey(value) >> shift) & 0xFF);
+            }
+            arr[next[d]++] = value;
+        }
+    }
+
+    if (shift == 0) return;
+    int start = 0;
+    for (int d = 0; d < 256; ++d) {
+        if (count[d] > 1) {
+            americanFlagSortImpl(arr + start, count[d], shift - 8);
+        }
+        start += count[d];
+    }
+}
+
+void americanFlagSort(int arr[], int n) { americanFlagSortImpl(arr, n, 24); }
+void americanFlagSort64(long long arr[], int n) { americanFlagSortImpl(arr, n, 56); }
+
+// ==========================================================
+// --- Generic Sort Dispatch (arithmetic fast paths, key-index mode) ---
+// ==========================================================
+
+// Inputs at least this large with an arithmetic key go to LSD radix sort
+const int GENERIC_RADIX_MIN_N = 1 << 12;
+// Records larger than this are sorted through a key-index permutation
+const size_t KEY_INDEX_RECORD_BYTES = 64;
+
+// True when comp orders keys ascending by operator< (so radix order agrees)
+template <typename Comp, typename Key>
+constexpr bool isAscendingOrder = is_same_v<Comp, less<>> || is_same_v<Comp, less<Key>>;
+
+// Keys that radixKey() can map to order-preserving unsigned bits
+template <typename Key>
+constexpr bool isRadixKey = (is_integral_v<Key> && !is_same_v<Key, bool>) ||
+                            is_same_v<Key, float> || is_same_v<Key, double>;
+
+// Iterators whose elements are contiguous in memory (C++17 has no concept for it)
+template <typename Iter>
+constexpr bool isContiguousIterator =
+    is_pointer_v<Iter> ||
+    is_same_v<Iter, typename vector<typename iterator_traits<Iter>::value_type>::iterator>;
+
+// (key, original position) pair sorted in place of a record
+template <typename Key>
+struct KeyIndexPair {
+    Key key;
+    unsigned int index;
+};
+
+template <typename Key>
+inline auto radixKey(const KeyIndexPair<Key>& entry) { return radixKey(entry.key); }
+
+// Moves first[order[i]] to position i for every i, following permutation
+// cycles so that each record is moved once (plus one temporary per cycle).
+template <typename Stats = NoSortStats, typename Iter, typename Index>
+void applyPermutation(Iter first, const vector<Index>& order) {
+    size_t n = order.size();
+    vector<bool> placed(n, false);
+    for (size_t start = 0; start < n; ++start) {
+        if (placed[start] || (size_t)order[start] == start) continue;
+        auto carried = move(first[start]);
+        size_t hole = start;
+        while (true) {
+            placed[hole] = true;
+            size_t source = (size_t)order[hole];
+            if (source == start) {
+                first[hole] = move(carried);
+                Stats::moved(2);
+                break;
+            }
+            first[hole] = move(first[source]);
+            Stats::moved(1);
+            hole = source;
+        }
+    }
+}
+
+// Key-index ("sort pointers, not payloads") mode: returns the stable sorted
+// order as positions into [first, last) without moving any record. Ties on
+// the key are broken by original position.
+template <typename Stats = NoSortStats, typename Iter, typename Comp = less<>, typename Proj = IdentityProjection>
+vector<size_t> sortedKeyIndex(Iter first, Iter last, Comp comp = Comp(), Proj proj = Proj()) {
+    vector<size_t> order((size_t)(last - first));
+    Stats::scratch(order.size() * sizeof(size_t));
+    iota(order.begin(), order.end(), (size_t)0);
+    auto byKey = [&](size_t a, size_t b) {
+        const auto& keyA = invoke(proj, first[a]);
+        const auto& keyB = invoke(proj, first[b]);
+        if (invoke(comp, keyA, keyB)) return true;
+        if (invoke(comp, keyB, keyA)) return false;
+        return a < b;
+    };
+    quickSort<Stats>(order.begin(), order.end(), byKey);
+    return order;
+}
+
+// Sorts large records by swapping 8-byte indices, then moves each record once
+template <typename Stats = NoSortStats, typename Iter, typename Comp = less<>, typename Proj = IdentityProjection>
+void sortByKeyIndex(Iter first, Iter last, Comp comp = Comp(), Proj proj = Proj()) {
+    applyPermutation<Stats>(first, sortedKeyIndex<Stats>(first, last, comp, proj));
+}
+
+// Stable LSD radix sort of any range by an arithmetic projected key (ascending).
+// Contiguous ranges of plain numbers are sorted directly; anything else sorts
+// (key, index) pairs and then applies the permutation to the records.
+template <typename Stats = NoSortStats, typename Iter, typename Proj = IdentityProjection>
+void radixSortByKey(Iter first, Iter last, Proj proj = Proj()) {
+    using Value = typename iterator_traits<Iter>::value_type;
+    using Key = decay_t<invoke_result_t<Proj&, Value&>>;
+    static_assert(isRadixKey<Key>, "radixSortByKey needs an arithmetic key");
+    int n = (int)(last - first);
+    if (n < 2) return;
+
+    if constexpr (is_same_v<Value, Key> && is_same_v<Proj, IdentityProjection> && isContiguousIterator<Iter>) {
+        lsdRadixSortImpl<Stats>(&*first, n, 11);
+    } else {
+        vector<KeyIndexPair<Key>> entries((size_t)n);
+        Stats::scratch((size_t)n * (sizeof(KeyIndexPair<Key>) + sizeof(unsigned int)));
+        for (int i = 0; i < n; ++i) {
+            entries[i].key = invoke(proj, first[i]);
+            entries[i].index = (unsigned int)i;
+        }
+        lsdRadixSortImpl<Stats>(entries.data(), n, sizeof(Key) > 4 ? 16 : 11);
+        vector<unsigned int> order((size_t)n);
+        for (int i = 0; i < n; ++i) {
+            order[i] = entries[i].index;
+        }
+        applyPermutation<Stats>(first, order);
+    }
+}
+
+// General entry point. The strategy is picked at compile time from the key,
+// comparator and element types:
+//   - arithmetic key, ascending order, large input -> LSD radix (direct or key-index)
+//   - contiguous ints, small input                 -> block-partition quickSort
+//   - records over KEY_INDEX_RECORD_BYTES          -> key-index permutation
+//   - everything else                               -> generic introsort
+// Not stable; use stableSortRange when equal keys must keep their order.
+template <typename Stats = NoSortStats, typename Iter, typename Comp = less<>, typename Proj = IdentityProjection>
+void sortRange(Iter first, Iter last, Comp comp = Comp(), Proj proj = Proj()) {
+    using Value = typename iterator_traits<Iter>::value_type;
+    using Key = decay_t<invoke_result_t<Proj&, Value&>>;
+    auto n = last - first;
+    if (n < 2) return;
+
+    if constexpr (isRadixKey<Key> && isAscendingOrder<Comp, Key>) {
+        if (n >= GENERIC_RADIX_MIN_N) {
+            radixSortByKey<Stats>(first, last, proj);
+            return;
+        }
+        // The block partition is not instrumented, so counted runs take the
+        // generic introsort below instead
+        if constexpr (is_same_v<Value, int> && is_same_v<Proj, IdentityProjection> && isContiguousIterator<Iter> &&
+                      !Stats::enabled) {
+            quickSort(&*first, 0, (int)n - 1, QUICK_BLOCK);
+            return;
+        }
+    }
+    if constexpr (sizeof(Value) > KEY_INDEX_RECORD_BYTES) {
+        sortByKeyIndex<Stats>(first, last, comp, proj);
+    } else {
+        quickSort<Stats>(first, last, comp, proj);
+    }
+}
+
+// Stable counterpart of sortRange: radix for large integral keys, key-index
+// for large records, merge sort otherwise. Floating-point keys never take the
+// radix path: it orders -0.0 before +0.0, which less<> treats as equal, so
+// equal keys could swap places.
+template <typename Stats = NoSortStats, typename Iter, typename Comp = less<>, typename Proj = IdentityProjection>
+void stableSortRange(Iter first, Iter last, Comp comp = Comp(), Proj proj = Proj()) {
+    using Value = typename iterator_traits<Iter>::value_type;
+    using Key = decay_t<invoke_result_t<Proj&, Value&>>;
+    auto n = last - first;
+    if (n < 2) return;
+
+    if constexpr (isRadixKey<Key> && is_integral_v<Key> && isAscendingOrder<Comp, Key>) {
+        if (n >= GENERIC_RADIX_MIN_N) {
+            radixSortByKey<Stats>(first, last, proj);
+            return;
+        }
+    }
+    if constexpr (sizeof(Value) > KEY_INDEX_RECORD_BYTES) {
+        sortByKeyIndex<Stats>(first, last, comp, proj);
+    } else {
+        mergeSort<Stats>(first, last, comp, proj);
+    }
+}
+
+// ==========================================================
+// --- Sort-by-Key with Separate Payload Arrays (SoA layout) ---
+// ==========================================================
+
+// Records stored as a structure of arrays: one int key array plus any number
+// of payload arrays. Only (key, index) pairs are sorted; every payload array
+// is then gathered through the resulting permutation in one sequential pass,
+// so a payload element is moved exactly once no matter how many swaps or
+// merge passes the keys needed.
+//   BY_KEY_STABLE_RADIX: LSD radix sort of the pairs (stable, O(n))
+//   BY_KEY_STABLE_MERGE: merge sort of the pairs (stable, comparison based)
+//   BY_KEY_UNSTABLE:     introsort of the pairs (equal keys may reorder)
+enum SortByKeyMode { BY_KEY_STABLE_RADIX, BY_KEY_STABLE_MERGE, BY_KEY_UNSTABLE };
+
+void sortKeyIndexPairs(vector<KeyIndexPair<int>>& pairs, SortByKeyMode mode) {
+    if (mode == BY_KEY_STABLE_RADIX) {
+        lsdRadixSortImpl(pairs.data(), (int)pairs.size(), 11);
+    } else if (mode == BY_KEY_STABLE_MERGE) {
+        mergeSort(pairs.begin(), pairs.end(), less<>(), &KeyIndexPair<int>::key);
+    } else {
+        quickSort(pairs.begin(), pairs.end(), less<>(), &KeyIndexPair<int>::key);
+    }
+}
+
+vector<KeyIndexPair<int>> sortedKeyIndexPairs(const int keys[], int n, SortByKeyMode mode) {
+    vector<KeyIndexPair<int>> pairs((size_t)max(0, n));
+    for (int i = 0; i < n; ++i) {
+        pairs[i].key = keys[i];
+        pairs[i].index = (unsigned int)i;
+    }
+    sortKeyIndexPairs(pairs, mode);
+    return pairs;
+}
+
+// Permutation index: order[i] is the position in keys[] of the i-th smallest key.
+// Neither the keys nor any payload are moved.
+vector<unsigned int> sortPermutationByKey(const int keys[], int n, SortByKeyMode mode = BY_KEY_STABLE_RADIX) {
+    vector<KeyIndexPair<int>> pairs = sortedKeyIndexPairs(keys, n, mode);
+    vector<unsigned int> order(pairs.size());
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        order[i] = pairs[i].index;
+    }
+    return order;
+}
+
+// payload[i] = old payload[order[i]] for every i, through one scratch copy
+template <typename Payload>
+void gatherPayload(Payload payload[], const vector<KeyIndexPair<int>>& order) {
+    vector<Payload> gathered;
+    gathered.reserve(order.size());
+    for (const KeyIndexPair<int>& entry : order) {
+        gathered.push_back(move(payload[entry.index]));
+    }
+    move(gathered.begin(), gathered.end(), payload);
+}
+
+// Sorts keys[0..n-1] and permutes every payload array in lockstep:
+//   sortByKey(keys, n, BY_KEY_STABLE_RADIX, prices, names, timestamps);
+template <typename... Payloads>
+void sortByKey(int keys[], int n, SortByKeyMode mode, Payloads*... payloads) {
+    if (n < 2) return;
+    vector<KeyIndexPair<int>> pairs = sortedKeyIndexPairs(keys, n, mode);
+    for (int i = 0; i < n; ++i) {
+        keys[i] = pairs[i].key;
+    }
+    (gatherPayload(payloads, pairs), ...);
+}
+
+// ==========================================================
+// --- Parallel Sample Sort (multi-core, configurable threads) ---
+// ==========================================================
+
+const int SAMPLE_SORT_MIN_N = 1 << 16;      // Smaller inputs just use the block quickSort
+const int SAMPLE_SORT_OVERSAMPLING = 32;    // Samples drawn per bucket
+const int SAMPLE_SORT_BUCKETS_PER_THREAD = 8;
+const int SAMPLE_SORT_MAX_THREADS = 4096;   // Keeps every bucket index within 16 bits
+
+// Runs body(0..threads-1) on 'threads' threads, the caller acting as thread 0
+void runOnThreads(int threads, const function<void(int)>& body) {
+    vector<thread> helpers;
+    for (int t = 1; t < threads; ++t) {
+        helpers.push_back(thread(body, t));
+    }
+    body(0);
+    for (thread& helper : helpers) helper.join();
+}
+
+// 1. Draw buckets * OVERSAMPLING random samples, sort them and keep every
+//    OVERSAMPLING-th one as a splitter, dropping repeated splitters.
+// 2. Each thread classifies its contiguous chunk (binary search over the
+//    splitters) into a private histogram. Splitter i owns two buckets: 2i for
+//    keys between splitter i-1 and splitter i, and 2i+1 for keys equal to
+//    splitter i. Equal buckets need no sorting, so heavily repeated values
+//    (few-unique, Zipf) no longer pile up in one bucket sorted by one thread.
+// 3. Prefix sums over (bucket, thread) give every thread its own write range in
+//    each bucket, so the scatter into the scratch array needs no locking.
+// 4. Buckets are claimed dynamically and sorted with the local block quickSort,
+//    then copied back in place.
+void parallelSampleSort(int arr[], int n, int threads) {
+    // At least SAMPLE_SORT_MIN_N elements per thread
+    threads = min(threads, min(n / SAMPLE_SORT_MIN_N, SAMPLE_SORT_MAX_THREADS));
+    if (threads <= 1) {
+        quickSort(arr, 0, n - 1, QUICK_BLOCK);
+        return;
+    }
+    int sampleBuckets = threads * SAMPLE_SORT_BUCKETS_PER_THREAD;
+
+    // 1. Splitters by oversampling, without duplicates
+    int sampleCount = sampleBuckets * SAMPLE_SORT_OVERSAMPLING;
+    vector<int> samples(sampleCount);
+    mt19937 rng((unsigned int)n);
+    for (int i = 0; i < sampleCount; ++i) {
+        samples[i] = arr[rng() % (unsigned int)n];
+    }
+    sort(samples.begin(), samples.end());
+    vector<int> splitters(sampleBuckets - 1);
+    for (int b = 0; b < sampleBuckets - 1; ++b) {
+        splitters[b] = samples[(b + 1) * SAMPLE_SORT_OVERSAMPLING];
+    }
+    splitters.erase(unique(splitters.begin(), splitters.end()), splitters.end());
+    int buckets = 2 * (int)splitters.size() + 1; // Range and equal bucket per splitter, plus the last range
+
+    // 2. Per-thread classification and histograms
+    vector<unsigned short> bucketOf(n);
+    vector<int> histogram((size_t)threads * buckets, 0);
+    int chunk = (n + threads - 1) / threads;
+    runOnThreads(threads, [&](int t) {
+        int begin = t * chunk;
+        int end = (begin + chunk < n) ? begin + chunk : n;
+        int* counts = &histogram[(size_t)t * buckets];
+        for (int i = begin; i < end; ++i) {
+            auto it = lower_bound(splitters.begin(), splitters.end(), arr[i]);
+            int b = 2 * (int)(it - splitters.begin());
+            if (it != splitters.end() && *it == arr[i]) b++;
+            bucketOf[i] = (unsigned short)b;
+            counts[b]++;
+        }
+    });
+
+    // 3. Offsets: bucket-major, then thread order inside a bucket
+    vector<int> offsets((size_t)threads * buckets);
+    vector<int> bucketStart(buckets + 1);
+    int running = 0;
+    for (int b = 0; b < buckets; ++b) {
+        bucketStart[b] = running;
+        for (int t = 0; t < threads; ++t) {
+            offsets[(size_t)t * buckets + b] = running;
+            running += histogram[(size_t)t * buckets + b];
+        }
+    }
+    bucketStart[buckets] = n;
+
+    int* scratch = new int[n];
+    runOnThreads(threads, [&](int t) {
+        int begin = t * chunk;
+        int end = (begin + chunk < n) ? begin + chunk : n;
+        int* next = &offsets[(size_t)t * buckets];
+        for (int i = begin; i < end; ++i) {
+            scratch[next[bucketOf[i]]++] = arr[i];
+        }
+    });
+
+    // 4. Sort range buckets concurrently and copy every bucket back
+    atomic<int> nextBucket(0);
+    runOnThreads(threads, [&](int) {
+        int b;
+        while ((b = nextBucket.fetch_add(1)) < buckets) {
+            int begin = bucketStart[b];
+            int size = bucketStart[b + 1] - begin;
+            bool equalBucket = (b % 2 == 1);
+            if (size > 1 && !equalBucket) quickSort(scratch + begin, 0, size - 1, QUICK_BLOCK);
+            memcpy(arr + begin, scratch + begin, (size_t)size * sizeof(int));
+        }
+    });
+    delete[] scratch;
+}
+
+// Dispatcher entry point: one thread per hardware core
+void parallelSampleSortAllCores(int arr[], int n) {
+    parallelSampleSort(arr, n, (int)thread::hardware_concurrency());
+}
+
+// ==========================================================
+// --- External (Out-of-Core) Merge Sort for Binary Int Files ---
+// ==========================================================
+
+// Sorts a file of native 32-bit ints that may be larger than memory:
+// 1. Run formation: read memoryBytes at a time with large sequential reads,
+//    sort the chunk in RAM (block quickSort) and spill it to a temp file.
+// 2. K-way merge: a loser tree picks the smallest head among the runs. Each run
+//    is read through its own buffer; with asyncReads the next buffer is filled
+//    by a background read while the current one is consumed (double buffering).
+//    When there are more runs than the budget can give buffers to, runs are
+//    merged in several passes.
+struct ExternalSortOptions {
+    size_t memoryBytes;   // Peak memory for data buffers
+    bool asyncReads;      // Double-buffered background reads during merging
+
+    ExternalSortOptions() : memoryBytes(64u << 20), asyncReads(true) {}
+};
+
+const size_t EXTERNAL_MIN_BUFFER_INTS = 16384; // 64 KB per run buffer at least
+
+// Sequential reader over one sorted run
+class RunReader {
+private:
+    FILE* file;
+    vector<int> current;
+    vector<int> next;
+    size_t position;
+    size_t length;
+    bool asyncReads;
+    future<size_t> pending;
+
+    size_t readInto(vector<int>& buffer) {
+        return fread(buffer.data(), sizeof(int), buffer.size(), file);
+    }
+
+    void startNextRead() {
+        pending = async(launch::async, [this]() { return readInto(next); });
+    }
+
+public:
+    RunReader(FILE* f, size_t bufferInts, bool useAsync)
+        : file(f), current(bufferInts), next(useAsync ? bufferInts : 0), position(0), length(0), asyncReads(useAsync) {
+        length = readInto(current);
+        if (asyncReads && length == current.size()) startNextRead();
+    }
+
+    ~RunReader() {
+        if (pending.valid()) pending.wait();
+    }
+
+    bool exhausted() const { return position >= length; }
+    int head() const { return current[position]; }
+
+    void advance() {
+        if (++position < length) return;
+        position = 0;
+        if (asyncReads) {
+            length = pending.valid() ? pending.get() : 0;
+            current.swap(next);
+            if (length == current.size()) startNextRead();
+        } else {
+            length = readInto(current);
+        }
+    }
+};
+
+// Tournament tree of losers over k readers: tree[0] holds the overall winner,
+// every other node the loser of the match played there, so replacing the
+// winner's value only replays the log2(k) matches on its path.
+class LoserTree {
+private:
+    vector<RunReader*>& sources;
+    vector<int> tree;
+    int k;
+
+    // True when source a should lose to source b (index k is a -infinity sentinel)
+    bool loses(int a, int b) const {
+        if (a == k) return false;
+        if (b == k) return true;
+        if (sources[a]->exhausted()) return true;
+        if (sources[b]->exhausted()) return false;
+        return sources[a]->head() > sources[b]->head();
+    }
+
+    void replay(int s) {
+        for (int t = (s + k) / 2; t > 0; t /= 2) {
+            if (loses(s, tree[t])) swap(s, tree[t]);
+        }
+        tree[0] = s;
+    }
+
+public:
+    explicit LoserTree(vector<RunReader*>& readers) : sources(readers), k((int)readers.size()) {
+        tree.assign(k, k);
+        for (int i = k - 1; i >= 0; --i) replay(i);
+    }
+
+    bool empty() const { return sources[tree[0]]->exhausted(); }
+    int top() const { return sources[tree[0]]->head(); }
+
+    void pop() {
+        int winner = tree[0];
+        sources[winner]->advance();
+        replay(winner);
+    }
+};
+
+// Merges the given sorted run files into 'out' using bufferInts per reader.
+// Returns false if a run could not be read or the output could not be written.
+bool mergeRuns(vector<FILE*>& runs, FILE* out, size_t bufferInts, bool asyncReads) {
+    vector<RunReader*> readers;
+    for (FILE* run : runs) {
+        rewind(run);
+        readers.push_back(new RunReader(run, bufferInts, asyncReads));
+    }
+    vector<int> output(bufferInts);
+    size_t used = 0;
+    bool ok = true;
+    if (!readers.empty()) {
+        LoserTree tree(readers);
+        while (ok && !tree.empty()) {
+            output[used++] = tree.top();
+            if (used == output.size()) {
+                ok = fwrite(output.data(), sizeof(int), used, out) == used;
+                used = 0;
+            }
+            tree.pop();
+        }
+    }
+    if (ok && used > 0) ok = fwrite(output.data(), sizeof(int), used, out) == used;
+    for (RunReader* reader : readers) delete reader;
+    for (FILE* run : runs) ok = ok && !ferror(run);
+    return ok && fflush(out) == 0 && !ferror(out);
+}
+
+bool externalSortFile(const string& inputPath, const string& outputPath, const ExternalSortOptions& options) {
+    // The budget must fund a two-way merge: two readers (each double-buffered
+    // with async reads) plus the output buffer, all of EXTERNAL_MIN_BUFFER_INTS
+    size_t buffersPerReader = options.asyncReads ? 2 : 1;
+    size_t budgetInts = options.memoryBytes / sizeof(int);
+    size_t minBudgetInts = EXTERNAL_MIN_BUFFER_INTS * (2 * buffersPerReader + 1);
+    if (budgetInts < minBudgetInts) {
+        cout << "Error: memory budget must be at least " << minBudgetInts * sizeof(int) / 1024
+             << " KB" << (options.asyncReads ? " with async reads" : "") << endl;
+        return false;
+    }
+
+    FILE* input = fopen(inputPath.c_str(), "rb");
+    if (input == nullptr) {
+        cout << "Error: cannot open input file " << inputPath << endl;
+        return false;
+    }
+    fseek(input, 0, SEEK_END);
+    long inputBytes = ftell(input);
+    rewind(input);
+    if (inputBytes < 0 || inputBytes % (long)sizeof(int) != 0) {
+        cout << "Error: " << inputPath << " is not a whole number of 4-byte ints" << endl;
+        fclose(input);
+        return false;
+    }
+
+    // 1. Run formation
+    size_t chunkInts = budgetInts;
+    vector<FILE*> runs;
+    {
+        vector<int> chunk(chunkInts);
+        size_t count;
+        while ((count = fread(chunk.data(), sizeof(int), chunkInts, input)) > 0) {
+            quickSort(chunk.data(), 0, (int)count - 1, QUICK_BLOCK);
+            FILE* run = tmpfile();
+            if (run == nullptr || fwrite(chunk.data(), sizeof(int), count, run) != count) {
+                cout << "Error: cannot write temporary run file" << endl;
+                if (run != nullptr) fclose(run);
+                for (FILE* r : runs) fclose(r);
+                fclose(input);
+                return false;
+            }
+            runs.push_back(run);
+        }
+    }
+    bool readFailed = ferror(input) != 0;
+    fclose(input);
+    if (readFailed) {
+        cout << "Error: cannot read input file " << inputPath << endl;
+        for (FILE* r : runs) fclose(r);
+        return false;
+    }
+
+    // 2. Merge passes: fan-in limited so every reader (plus the output) gets a
+    //    buffer of at least EXTERNAL_MIN_BUFFER_INTS, doubled when reads are async.
+    //    The minimum budget check above guarantees a fan-in of 2 fits.
+    size_t readerSlots = budgetInts / (EXTERNAL_MIN_BUFFER_INTS * buffersPerReader);
+    size_t maxFanIn = (readerSlots > 3) ? readerSlots - 1 : 2;
+
+    while (runs.size() > maxFanIn) {
+        vector<FILE*> merged;
+        for (size_t start = 0; start < runs.size(); start += maxFanIn) {
+            size_t end = (start + maxFanIn < runs.size()) ? start + maxFanIn : runs.size();
+            vector<FILE*> group(runs.begin() + start, runs.begin() + end);
+            FILE* out = tmpfile();
+            if (out == nullptr) {
+                cout << "Error: cannot create temporary merge file" << endl;
+                for (size_t i = start; i < runs.size(); ++i) fclose(runs[i]); // Earlier groups are already closed
+                for (FILE* r : merged) fclose(r);
+                return false;
+            }
+            size_t bufferInts = budgetInts / ((group.size() * buffersPerReader) + 1);
+            bool ok = mergeRuns(group, out, bufferInts, options.asyncReads);
+            for (FILE* r : group) fclose(r);
+            merged.push_back(out);
+            if (!ok) {
+                cout << "Error: cannot write temporary merge file" << endl;
+                for (size_t i = end; i < runs.size(); ++i) fclose(runs[i]);
+                for (FILE* r : merged) fclose(r);
+                return false;
+            }
+        }
+        runs.swap(merged);
+    }
+
+    FILE* output = fopen(outputPath.c_str(), "wb");
+    if (output == nullptr) {
+        cout << "Error: cannot open output file " << outputPath << endl;
+        for (FILE* r : runs) fclose(r);
+        return false;
+    }
+    size_t bufferInts = budgetInts / ((runs.size() * buffersPerReader) + 1);
+    bool ok = mergeRuns(runs, output, bufferInts, options.asyncReads);
+    for (FILE* r : runs) fclose(r);
+    ok = (fclose(output) == 0) && ok;
+    if (!ok) {
+        cout << "Error: cannot write output file " << outputPath << endl;
+    }
+    return ok;
+}
+
+// ==========================================================
+// --- Sort Algorithm Registry (shared by the demo and the benchmark) ---
+// ==========================================================
+
+// int[] entry points for the sorts whose own signature takes bounds or a mode
+template <typename Stats = NoSortStats>
+void mergeSortArray(int arr[], int n) { mergeSort<Stats>(arr, 0, n - 1); }
+template <typename Stats = NoSortStats>
+void quickSortArray(int arr[], int n) { quickSort<Stats>(arr, 0, n - 1); }
+void introSortArray(int arr[], int n) { quickSort(arr, 0, n - 1, QUICK_INTRO); }
+void blockQuickSortArray(int arr[], int n) { quickSort(arr, 0, n - 1, QUICK_BLOCK); }
+
+// Quadratic sorts (and the classic quickSort, quadratic on sorted input) are
+// skipped above this size
+const int QUADRATIC_SORT_MAX_N = 1 << 15;
+
+// Element type for counting the std:: baselines, which cannot take a Stats
+// policy: comparisons go through CountingLess, exchanges through the swap
+// overload below (found by argument-dependent lookup) and every other copy
+// or assignment counts as one move. All of it lands in sortCounters.
+struct CountedInt {
+    int value;
+
+    explicit CountedInt(int v) : value(v) {}
+    CountedInt(const CountedInt& other) : value(other.value) { CountingSortStats::moved(1); }
+    CountedInt& operator=(const CountedInt& other) {
+        value = other.value;
+        CountingSortStats::moved(1);
+        return *this;
+    }
+};
+
+inline void swap(CountedInt& a, CountedInt& b) {
+    CountingSortStats::swapped();
+    int temp = a.value;
+    a.value = b.value;
+    b.value = temp;
+}
+
+struct CountingLess {
+    bool operator()(const CountedInt& a, const CountedInt& b) const {
+        CountingSortStats::comparison();
+        return a.value < b.value;
+    }
+};
+
+// Sorts arr through CountedInt with the given std:: sort. Recursion depth and
+// scratch bytes are hidden inside the library, so they are reported as -1
+// (printed as "-" / null), not as zero.
+template <typename StdSort>
+void countStdSort(int arr[], int n, StdSort stdSort) {
+    SortCounters before = sortCounters;
+    vector<CountedInt> items;
+    items.reserve((size_t)max(0, n));
+    for (int i = 0; i < n; ++i) items.emplace_back(arr[i]);
+    sortCounters = before; // Loading the elements is not part of the sort
+    stdSort(items.begin(), items.end(), CountingLess());
+    for (int i = 0; i < n; ++i) arr[i] = items[i].value;
+    sortCounters.maxDepth = -1;
+    sortCounters.scratchBytes = -1;
+}
+
+struct SortAlgorithm {
+    const char* id;                         // Name used by --algos and in CSV/JSON output
+    void (*sortInts)(int[], int);
+    void (*sortInstrumented)(int[], int);   // Counts into sortCounters; nullptr if not instrumented
+    int maxN;
+};
+
+const vector<SortAlgorithm>& sortAlgorithms() {
+    static const vector<SortAlgorithm> algorithms = {
+        {"selection", selectionSort, selectionSort<CountingSortStats>, QUADRATIC_SORT_MAX_N},
+        {"insertion", insertionSort, insertionSort<CountingSortStats>, QUADRATIC_SORT_MAX_N},
+        {"bubble", bubbleSort, bubbleSort<CountingSortStats>, QUADRATIC_SORT_MAX_N},
+        {"improved-selection", improvedSelectionSort, improvedSelectionSort<CountingSortStats>, QUADRATIC_SORT_MAX_N},
+        {"merge", mergeSortArray, mergeSortArray<CountingSortStats>, INT_MAX},
+        {"quick-classic", quickSortArray, quickSortArray<CountingSortStats>, QUADRATIC_SORT_MAX_N},
+        // Counted through the generic instantiation of the same scheme
+        {"introsort", introSortArray,
+         [](int a[], int n) { quickSort<CountingSortStats>(a, a + n); }, INT_MAX},
+        {"block-quick", blockQuickSortArray, nullptr, INT_MAX},
+        {"powersort", naturalMergeSort,
+         [](int a[], int n) { naturalMergeSort<CountingSortStats>(a, a + n); }, INT_MAX},
+        {"radix-lsd8", radixSortLSD, nullptr, INT_MAX},
+        {"radix-lsd11", radixSortLSD11, nullptr, INT_MAX},
+        {"radix-lsd16", radixSortLSD16, nullptr, INT_MAX},
+        {"american-flag", americanFlagSort, nullptr, INT_MAX},
+        {"sample-sort", parallelSampleSortAllCores, nullptr, INT_MAX},
+        {"sort-range", [](int a[], int n) { sortRange(a, a + n); }, nullptr, INT_MAX},
+        {"std-sort", [](int a[], int n) { sort(a, a + n); },
+         [](int a[], int n) {
+             countStdSort(a, n, [](auto first, auto last, CountingLess less) { sort(first, last, less); });
+         }, INT_MAX},
+        {"std-stable-sort", [](int a[], int n) { stable_sort(a, a + n); },
+         [](int a[], int n) {
+             countStdSort(a, n, [](auto first, auto last, CountingLess less) { stable_sort(first, last, less); });
+         }, INT_MAX},
+    };
+    return algorithms;
+}
+
+// ==========================================================
+// --- Main Function and Demonstration ---
+// ==========================================================
+
+// Prints the operation counts of the last CountingSortStats run
+void printSortCounters(const SortCounters& c) {
+    cout << "Counts: " << c.comparisons << " comparisons, " << c.moves << " moves ("
+         << c.swaps << " swaps), recursion depth " << c.maxDepth << ", "
+         << c.scratchBytes << " scratch bytes" << endl;
+}
+
+// Helper function to run the demo for Q1 sorting functions. When an
+// instrumented instantiation is given, it sorts another copy and its counts are shown.
+void runSortDemo(const string& name, void (*sortFunc)(int[], int), int arr[], int n,
+                 void (*instrumentedFunc)(int[], int) = nullptr) {
+    // Create a temporary array to hold the original data for the demo
+    int temp_arr[n];
+    for (int i = 0; i < n; ++i) {
+        temp_arr[i] = arr[i];
+    }
+
+    cout << "\n--- Running " << name << " ---" << endl;
+    printArray(temp_arr, n, "Original");
+    
+    sortFunc(temp_arr, n);
+    
+    printArray(temp_arr, n, "Sorted");
+
+    if (instrumentedFunc != nullptr) {
+        for (int i = 0; i < n; ++i) {
+            temp_arr[i] = arr[i];
+        }
+        sortCounters.reset();
+        instrumentedFunc(temp_arr, n);
+        printSortCounters(sortCounters);
+    }
+}
+
+// Generic API demo: records by member, reverse order, strings, 64-bit and float keys
+struct StudentRecord {
+    string name;
+    int score;
+};
+
+void runGenericSortDemo() {
+    cout << "\n=======================================================" << endl;
+    cout << "  Generic Sort API (iterators + comparator + projection)" << endl;
+    cout << "=======================================================" << endl;
+
+    vector<StudentRecord> students = {{"Asha", 82}, {"Ben", 67}, {"Chen", 91}, {"Dev", 67}, {"Eva", 75}};
+    stableSortRange(students.begin(), students.end(), less<>(), &StudentRecord::score);
+    cout << "\nStudents by score (stable):";
+    for (const StudentRecord& s : students) cout << " " << s.name << "(" << s.score << ")";
+    cout << endl;
+
+    vector<size_t> order = sortedKeyIndex(students.begin(), students.end(), less<>(), &StudentRecord::name);
+    cout << "Key-index order by name (records not moved):";
+    for (size_t index : order) cout << " " << students[index].name;
+    cout << endl;
+
+    vector<string> words = {"merge", "quick", "bubble", "radix", "insertion", "heap"};
+    insertionSort(words.begin(), words.end());
+    cout << "Strings (insertionSort):";
+    for (const string& w : words) cout << " " << w;
+    cout << endl;
+
+    vector<double> values = {3.5, -1.25, 0.0, 2.75, -8.5, 1.0};
+    mergeSort(values.begin(), values.end(), greater<>());
+    cout << "Doubles descending (mergeSort):";
+    for (double v : values) cout << " " << v;
+    cout << endl;
+
+    vector<long long> bigKeys = {5000000000LL, -3, 42, -7000000000LL, 0};
+    sortRange(bigKeys.begin(), bigKeys.end());
+    cout << "64-bit keys (sortRange):";
+    for (long long v : bigKeys) cout << " " << v;
+    cout << endl;
+
+    vector<int> byLastDigit = {64, 25, 12, 22, 11, 75, 5, 33};
+    quickSort(byLastDigit.begin(), byLastDigit.end(), less<>(), [](int v) { return v % 10; });
+    cout << "Ints by last digit (quickSort + projection):";
+    for (int v : byLastDigit) cout << " " << v;
+    cout << endl;
+}
+
+// ==========================================================
+// --- Merge Sort Benchmark (--bench-merge [maxN]) ---
+// ==========================================================
+
+// The original recursive merge sort with stack VLAs at every level, kept only
+// as the benchmark baseline. Its temporaries overflow the stack on big inputs,
+// so it is only run up to LEGACY_MERGE_MAX_N elements.
+const long long LEGACY_MERGE_MAX_N = 1000000;
+
+void legacyMerge(int arr[], int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+    int L[n1];
+    int R[n2];
+    for (int i = 0; i < n1; i++) L[i] = arr[left + i];
+    for (int j = 0; j < n2; j++) R[j] = arr[mid + 1 + j];
+    int i = 0, j = 0, k = left;
+    while (i < n1 && j < n2) arr[k++] = (L[i] <= R[j]) ? L[i++] : R[j++];
+    while (i < n1) arr[k++] = L[i++];
+    while (j < n2) arr[k++] = R[j++];
+}
+
+void legacyMergeSort(int arr[], int left, int right) {
+    if (left >= right) return;
+    int mid = left + (right - left) / 2;
+    legacyMergeSort(arr, left, mid);
+    legacyMergeSort(arr, mid + 1, right);
+    legacyMerge(arr, left, mid, right);
+}
+
+double timeSortMs(const vector<int>& input, vector<int>& output, const function<void(int*, int)>& sorter) {
+    output = input;
+    auto start = chrono::steady_clock::now();
+    sorter(output.data(), (int)output.size());
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void runMergeSortBenchmark(long long maxN) {
+    cout << "\n--- Merge Sort Benchmark (random ints, "
+         << sortThreadPool().threadCount() << " pool threads) ---" << endl;
+    mt19937 rng(42);
+    for (long long n = 1000000; n <= maxN; n *= 10) {
+        vector<int> input(n);
+        for (long long i = 0; i < n; ++i) input[i] = (int)rng();
+        vector<int> reference;
+        vector<int> output;
+
+        double stdMs = timeSortMs(input, reference, [](int* a, int len) { stable_sort(a, a + len); });
+        double seqMs = timeSortMs(input, output, [](int* a, int len) {
+            int* scratch = new int[len];
+            mergeSortRange(a, scratch, 0, len - 1, nullptr);
+            delete[] scratch;
+        });
+        bool identical = (output == reference);
+        double parMs = timeSortMs(input, output, [](int* a, int len) {
+            int* scratch = new int[len];
+            mergeSortRange(a, scratch, 0, len - 1, &sortThreadPool());
+            delete[] scratch;
+        });
+        identical = identical && (output == reference);
+
+        cout << "n = " << n << endl;
+        if (n <= LEGACY_MERGE_MAX_N) {
+            double legacyMs = timeSortMs(input, output, [](int* a, int len) { legacyMergeSort(a, 0, len - 1); });
+            identical = identical && (output == reference);
+            cout << "  Original mergeSort (VLA):   " << legacyMs << " ms" << endl;
+        } else {
+            cout << "  Original mergeSort (VLA):   skipped (stack overflow risk)" << endl;
+        }
+        cout << "  Merge sort, sequential:     " << seqMs << " ms" << endl;
+        cout << "  Merge sort, parallel:       " << parMs << " ms" << endl;
+        cout << "  std::stable_sort:           " << stdMs << " ms" << endl;
+        cout << "  Output identical: " << (identical ? "Yes" : "No") << endl;
+    }
+}
+
+// ==========================================================
+// --- Quick Sort Adversarial Benchmark (--bench-quick [n]) ---
+// ==========================================================
+
+// Inputs that defeat a last-element pivot: the classic quickSort is quadratic
+// (and recurses n deep) on all of them except random, so it is only timed at
+// CLASSIC_QUICK_MAX_N elements.
+const int CLASSIC_QUICK_MAX_N = 20000;
+const char* QUICK_PATTERN_NAMES[] = {"sorted", "reverse", "all-equal", "organ-pipe", "random"};
+const int QUICK_PATTERN_COUNT = 5;
+
+void fillQuickPattern(vector<int>& data, int pattern) {
+    int n = (int)data.size();
+    mt19937 rng(7);
+    for (int i = 0; i < n; ++i) {
+        switch (pattern) {
+            case 0: data[i] = i; break;
+            case 1: data[i] = n - i; break;
+            case 2: data[i] = 42; break;
+            case 3: data[i] = (i < n / 2) ? i : n - i; break;
+            default: data[i] = (int)rng(); break;
+        }
+    }
+}
+
+void runQuickSortBenchmark(int n) {
+    cout << "\n--- Quick Sort Adversarial Benchmark ---" << endl;
+    int sizes[] = {CLASSIC_QUICK_MAX_N, n};
+    for (int size : sizes) {
+        cout << "n = " << size << endl;
+        for (int p = 0; p < QUICK_PATTERN_COUNT; ++p) {
+            vector<int> input(size);
+            fillQuickPattern(input, p);
+            vector<int> reference;
+            vector<int> output;
+
+            double stdMs = timeSortMs(input, reference, [](int* a, int len) { sort(a, a + len); });
+            double introMs = timeSortMs(input, output, [](int* a, int len) { quickSort(a, 0, len - 1, QUICK_INTRO); });
+            bool identical = (output == reference);
+            double blockMs = timeSortMs(input, output, [](int* a, int len) { quickSort(a, 0, len - 1, QUICK_BLOCK); });
+            identical = identical && (output == reference);
+
+            cout << "  " << QUICK_PATTERN_NAMES[p] << ": introsort " << introMs << " ms, block " << blockMs
+                 << " ms, std::sort " << stdMs << " ms";
+            if (size <= CLASSIC_QUICK_MAX_N) {
+                double classicMs = timeSortMs(input, output, [](int* a, int len) { quickSort(a, 0, len - 1, QUICK_CLASSIC); });
+                identical = identical && (output == reference);
+                cout << ", classic " << classicMs << " ms";
+            }
+            cout << (identical ? "" : "  [MISMATCH]") << endl;
+        }
+    }
+
+    // One partition pass over random 32-bit keys: Lomuto loop vs block partition,
+    // both around the same (median-of-three) pivot value
+    vector<int> input(n);
+    fillQuickPattern(input, 4);
+    int pivotIndex = medianOfThree(input.data(), 0, n / 2, n - 1);
+    vector<int> lomutoData = input;
+    swapElements(lomutoData[pivotIndex], lomutoData[n - 1]);
+    vector<int> blockData = input;
+    swapElements(blockData[pivotIndex], blockData[0]);
+
+    auto start = chrono::steady_clock::now();
+    int lomutoPos = partition(lomutoData.data(), 0, n - 1);
+    auto mid = chrono::steady_clock::now();
+    int blockPos = blockPartition(blockData.data(), 0, n - 1);
+    auto end = chrono::steady_clock::now();
+    cout << "Single partition of " << n << " random keys: Lomuto "
+         << chrono::duration<double, milli>(mid - start).count() << " ms, block "
+         << chrono::duration<double, milli>(end - mid).count() << " ms"
+         << (lomutoPos == blockPos ? "" : "  [MISMATCH]") << endl;
+}
+
+// ==========================================================
+// --- Radix Sort Benchmark (--bench-radix [n]) ---
+// ==========================================================
+
+void runRadixSortBenchmark(int n) {
+    cout << "\n--- Radix vs Comparison Sorts (" << n << " random signed keys) ---" << endl;
+    mt19937 rng(11);
+    vector<int> input(n);
+    for (int i = 0; i < n; ++i) input[i] = (int)rng();
+    vector<int> reference;
+    vector<int> output;
+
+    struct Entry { const char* name; function<void(int*, int)> sorter; };
+    vector<Entry> entries = {
+        {"std::sort                ", [](int* a, int len) { sort(a, a + len); }},
+        {"Introsort quickSort      ", [](int* a, int len) { quickSort(a, 0, len - 1, QUICK_INTRO); }},
+        {"Block quickSort          ", [](int* a, int len) { quickSort(a, 0, len - 1, QUICK_BLOCK); }},
+        {"mergeSort                ", [](int* a, int len) { mergeSort(a, 0, len - 1); }},
+        {"LSD radix (8-bit digits) ", radixSortLSD},
+        {"LSD radix (11-bit digits)", radixSortLSD11},
+        {"LSD radix (16-bit digits)", radixSortLSD16},
+        {"MSD American flag        ", americanFlagSort},
+    };
+    timeSortMs(input, reference, entries[0].sorter);
+    for (const Entry& entry : entries) {
+        double ms = timeSortMs(input, output, entry.sorter);
+        cout << "  " << entry.name << ": " << ms << " ms" << (output == reference ? "" : "  [MISMATCH]") << endl;
+    }
+
+    // 64-bit keys
+    vector<long long> input64(n);
+    for (int i = 0; i < n; ++i) input64[i] = (long long)(((unsigned long long)rng() << 32) | rng());
+    vector<long long> reference64 = input64;
+    auto start = chrono::steady_clock::now();
+    sort(reference64.begin(), reference64.end());
+    auto mid = chrono::steady_clock::now();
+    vector<long long> lsd64 = input64;
+    radixSortLSD64(lsd64.data(), n);
+    auto mid2 = chrono::steady_clock::now();
+    vector<long long> msd64 = input64;
+    americanFlagSort64(msd64.data(), n);
+    auto end = chrono::steady_clock::now();
+    cout << "  64-bit keys: std::sort " << chrono::duration<double, milli>(mid - start).count()
+         << " ms, LSD radix (11-bit) " << chrono::duration<double, milli>(mid2 - mid).count()
+         << " ms, MSD American flag " << chrono::duration<double, milli>(end - mid2).count() << " ms"
+         << ((lsd64 == reference64 && msd64 == reference64) ? "" : "  [MISMATCH]") << endl;
+}
+
+// ==========================================================
+// --- Sorting Network Microbenchmark (--bench-network) ---
+// ==========================================================
+
+// Sorts many independent small arrays of each kernel size and reports
+// throughput for insertionSort and for each available network kernel.
+void runNetworkBenchmark() {
+    cout << "\n--- Sorting Network Leaf Kernels (selected: " << networkKernelName << ") ---" << endl;
+    const int totalElements = 1 << 22;
+    mt19937 rng(5);
+    vector<int> input(totalElements);
+    for (int& x : input) x = (int)rng();
+
+    struct Kernel { const char* name; void (*sort)(int*, int); };
+    vector<Kernel> kernels = {{"insertionSort", scalarNetworkSort}};
+#ifdef SORT_HAVE_X86_SIMD
+    if (__builtin_cpu_supports("sse4.1")) kernels.push_back({"SSE4.1 network", sseNetworkSort});
+    if (__builtin_cpu_supports("avx2")) kernels.push_back({"AVX2 network", avx2NetworkSort});
+#endif
+
+    for (int size = 8; size <= NETWORK_MAX_SIZE; size *= 2) {
+        cout << "size " << size << ":";
+        vector<int> reference = input;
+        for (int i = 0; i < totalElements; i += size) sort(reference.begin() + i, reference.begin() + i + size);
+        for (const Kernel& kernel : kernels) {
+            vector<int> data = input;
+            auto start = chrono::steady_clock::now();
+            for (int i = 0; i < totalElements; i += size) kernel.sort(data.data() + i, size);
+            auto end = chrono::steady_clock::now();
+            double seconds = chrono::duration<double>(end - start).count();
+            cout << "  " << kernel.name << " " << totalElements / seconds / 1e6 << " M elem/s"
+                 << (data == reference ? "" : " [MISMATCH]");
+        }
+        cout << endl;
+    }
+
+#ifdef SORT_HAVE_X86_SIMD
+    // 8 + 8 register merge against the scalar merge of the same sorted pairs
+    if (__builtin_cpu_supports("avx2")) {
+        vector<int> runs = input;
+        for (int i = 0; i < totalElements; i += 8) sort(runs.begin() + i, runs.begin() + i + 8);
+        vector<int> scalarOut(totalElements);
+        vector<int> vectorOut(totalElements);
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < totalElements; i += 16) {
+            merge(runs.begin() + i, runs.begin() + i + 8, runs.begin() + i + 8, runs.begin() + i + 16,
+                  scalarOut.begin() + i);
+        }
+        auto middle = chrono::steady_clock::now();
+        for (int i = 0; i < totalElements; i += 16) avx2Merge8x8(&runs[i], &runs[i + 8], &vectorOut[i]);
+        auto end = chrono::steady_clock::now();
+        cout << "merge 8+8: std::merge " << totalElements / chrono::duration<double>(middle - start).count() / 1e6
+             << " M elem/s  AVX2 bitonic merge " << totalElements / chrono::duration<double>(end - middle).count() / 1e6
+             << " M elem/s" << (vectorOut == scalarOut ? "" : " [MISMATCH]") << endl;
+    }
+#endif
+
+    // Whole sorts with each leaf sorter
+    vector<int> big(1000000);
+    for (int& x : big) x = (int)rng();
+    vector<int> reference;
+    vector<int> output;
+    timeSortMs(big, reference, [](int* a, int len) { sort(a, a + len); });
+    const char* leafNames[] = {"insertion leaves", "network leaves  "};
+    for (int mode = 0; mode < 2; ++mode) {
+        sortLeafMode = (LeafSortMode)mode;
+        double mergeMs = timeSortMs(big, output, [](int* a, int len) { mergeSort(a, 0, len - 1); });
+        bool identical = (output == reference);
+        double introMs = timeSortMs(big, output, [](int* a, int len) { quickSort(a, 0, len - 1, QUICK_INTRO); });
+        identical = identical && (output == reference);
+        double blockMs = timeSortMs(big, output, [](int* a, int len) { quickSort(a, 0, len - 1, QUICK_BLOCK); });
+        identical = identical && (output == reference);
+        cout << leafNames[mode] << ": mergeSort " << mergeMs << " ms, introsort " << introMs
+             << " ms, block quickSort " << blockMs << " ms" << (identical ? "" : " [MISMATCH]") << endl;
+    }
+    sortLeafMode = LEAF_INSERTION;
+}
+
+// ==========================================================
+// --- Sample Sort Scaling Benchmark (--bench-sample [n] [maxThreads]) ---
+// ==========================================================
+
+void runSampleSortBenchmark(int n, int maxThreads) {
+    cout << "\n--- Parallel Sample Sort Scaling (hardware threads: "
+         << thread::hardware_concurrency() << ") ---" << endl;
+    mt19937 rng(13);
+
+    // Strong scaling: fixed problem size, more threads
+    vector<int> input(n);
+    for (int& x : input) x = (int)rng();
+    vector<int> reference;
+    vector<int> output;
+    timeSortMs(input, reference, [](int* a, int len) { sort(a, a + len); });
+    cout << "Strong scaling (n = " << n << "):" << endl;
+    double baseMs = 0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double ms = timeSortMs(input, output, [threads](int* a, int len) { parallelSampleSort(a, len, threads); });
+        if (threads == 1) baseMs = ms;
+        cout << "  threads " << threads << ": " << ms << " ms, speedup " << baseMs / ms
+             << ", efficiency " << 100.0 * baseMs / ms / threads << "%"
+             << (output == reference ? "" : "  [MISMATCH]") << endl;
+    }
+
+    // Weak scaling: fixed work per thread
+    int perThread = n / maxThreads;
+    if (perThread < SAMPLE_SORT_MIN_N) perThread = SAMPLE_SORT_MIN_N;
+    cout << "Weak scaling (" << perThread << " elements per thread):" << endl;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        vector<int> weakInput((size_t)perThread * threads);
+        for (int& x : weakInput) x = (int)rng();
+        double ms = timeSortMs(weakInput, output, [threads](int* a, int len) { parallelSampleSort(a, len, threads); });
+        if (threads == 1) baseMs = ms;
+        cout << "  threads " << threads << " (n = " << weakInput.size() << "): " << ms
+             << " ms, efficiency " << 100.0 * baseMs / ms << "%"
+             << (is_sorted(output.begin(), output.end()) ? "" : "  [NOT SORTED]") << endl;
+    }
+}
+
+// ==========================================================
+// --- External Sort Benchmark (--bench-external [MB]) ---
+// ==========================================================
+
+void runExternalSortBenchmark(int fileMB) {
+    cout << "\n--- External Merge Sort (" << fileMB << " MB input file) ---" << endl;
+    const string inputPath = "external_sort_input.bin";
+    const string outputPath = "external_sort_output.bin";
+    size_t count = (size_t)fileMB * (1u << 20) / sizeof(int);
+
+    FILE* input = fopen(inputPath.c_str(), "wb");
+    if (input == nullptr) {
+        cout << "Error: cannot create " << inputPath << endl;
+        return;
+    }
+    mt19937 rng(17);
+    vector<int> block(1 << 20);
+    for (size_t written = 0; written < count; written += block.size()) {
+        size_t n = (count - written < block.size()) ? count - written : block.size();
+        for (size_t i = 0; i < n; ++i) block[i] = (int)rng();
+        fwrite(block.data(), sizeof(int), n, input);
+    }
+    fclose(input);
+
+    size_t budgetsMB[] = {4, 16, 64, 256};
+    for (size_t budgetMB : budgetsMB) {
+        for (int async = 0; async < 2; ++async) {
+            ExternalSortOptions options;
+            options.memoryBytes = budgetMB << 20;
+            options.asyncReads = (async == 1);
+
+            auto start = chrono::steady_clock::now();
+            bool ok = externalSortFile(inputPath, outputPath, options);
+            auto end = chrono::steady_clock::now();
+            double seconds = chrono::duration<double>(end - start).count();
+
+            // Verify: same number of ints, in non-decreasing order
+            FILE* check = fopen(outputPath.c_str(), "rb");
+            size_t seen = 0;
+            bool sortedOk = ok && check != nullptr;
+            int previous = -2147483647 - 1;
+            size_t got;
+            while (sortedOk && (got = fread(block.data(), sizeof(int), block.size(), check)) > 0) {
+                for (size_t i = 0; i < got; ++i) {
+                    if (block[i] < previous) sortedOk = false;
+                    previous = block[i];
+                }
+                seen += got;
+            }
+            if (check != nullptr) fclose(check);
+            sortedOk = sortedOk && (seen == count);
+
+            cout << "  memory " << budgetMB << " MB, " << (async ? "async reads" : "sync reads ") << ": "
+                 << fileMB / seconds << " MB/s (" << seconds << " s)" << (sortedOk ? "" : "  [FAILED]") << endl;
+        }
+    }
+    remove(inputPath.c_str());
+    remove(outputPath.c_str());
+}
+
+// ==========================================================
+// --- Adaptive Sort Benchmark (--bench-adaptive [n]) ---
+// ==========================================================
+
+// Nearly sorted feeds: fully presorted, k random swaps away from sorted, and a
+// sorted prefix with a random tail appended (plus fully random as a baseline)
+void fillNearlySorted(vector<int>& data, const string& pattern, int param, mt19937& rng) {
+    int n = (int)data.size();
+    for (int i = 0; i < n; ++i) data[i] = i;
+    if (pattern == "k-swaps") {
+        for (int k = 0; k < param; ++k) {
+            swap(data[rng() % n], data[rng() % n]);
+        }
+    } else if (pattern == "random tail") {
+        int tail = (int)((long long)n * param / 100);
+        for (int i = n - tail; i < n; ++i) data[i] = (int)(rng() % n);
+    } else if (pattern == "random") {
+        for (int i = 0; i < n; ++i) data[i] = (int)rng();
+    }
+}
+
+void runAdaptiveSortBenchmark(int n) {
+    struct Case {
+        const char* pattern;
+        int param;
+        const char* label;
+    };
+    const Case cases[] = {
+        {"presorted", 0, "presorted"},
+        {"k-swaps", 10, "10 swaps away"},
+        {"k-swaps", 1000, "1000 swaps away"},
+        {"random tail", 1, "1% random tail"},
+        {"random tail", 10, "10% random tail"},
+        {"random", 0, "fully random"},
+    };
+
+    cout << "\n--- Adaptive Sort Benchmark (n = " << n << ") ---" << endl;
+    mt19937 rng(42);
+    vector<int> input(n);
+    vector<int> reference;
+    vector<int> output;
+    for (const Case& c : cases) {
+        fillNearlySorted(input, c.pattern, c.param, rng);
+        double stdMs = timeSortMs(input, reference, [](int* a, int len) { stable_sort(a, a + len); });
+        double naturalMs = timeSortMs(input, output, [](int* a, int len) { naturalMergeSort(a, len); });
+        bool identical = (output == reference);
+        double mergeMs = timeSortMs(input, output, [](int* a, int len) { mergeSort(a, 0, len - 1); });
+        identical = identical && (output == reference);
+        double introMs = timeSortMs(input, output, [](int* a, int len) { quickSort(a, 0, len - 1, QUICK_INTRO); });
+        identical = identical && (output == reference);
+
+        cout << c.label << endl;
+        cout << "  Natural merge sort (powersort): " << naturalMs << " ms" << endl;
+        cout << "  Merge sort:                     " << mergeMs << " ms" << endl;
+        cout << "  Introsort quickSort:            " << introMs << " ms" << endl;
+        cout << "  std::stable_sort:               " << stdMs << " ms" << endl;
+        cout << "  Output identical: " << (identical ? "Yes" : "No") << endl;
+    }
+}
+
+// ==========================================================
+// --- Sorting Benchmark Harness (--bench-all [options]) ---
+// ==========================================================
+
+// Runs every registered sort over configurable sizes and input distributions.
+// Each (algorithm, distribution, n) cell gets 'warmup' untimed runs and 'reps'
+// timed runs on a fresh copy of the same input; median and p95 are reported.
+// Operation counts come from one extra untimed run of the algorithm's
+// CountingSortStats instantiation. Hardware counters are read through
+// perf_event when the kernel allows it (averaged over the timed runs).
+// Every input generator known to fillDistribution
+const vector<string> BENCH_DISTRIBUTIONS = {"uniform", "zipf", "sorted", "reverse", "few-unique", "sawtooth"};
+
+struct BenchOptions {
+    vector<int> sizes = {1000, 100000, 1000000};
+    vector<string> distributions = BENCH_DISTRIBUTIONS;
+    vector<string> algorithms;  // Empty: all registered sorts
+    int warmup = 1;
+    int reps = 5;
+    string format = "table";    // table, csv or json
+    string outputPath;          // Empty: stdout
+};
+
+struct BenchResult {
+    string algorithm;
+    string distribution;
+    int n;
+    int reps;
+    double medianMs;
+    double p95Ms;
+    double nsPerElement;
+    long long comparisons;      // Operation counts; -1 when the sort is not instrumented
+    long long moves;
+    long long swaps;
+    long long maxDepth;
+    long long scratchBytes;
+    long long hardware[4];      // cycles, instructions, branch misses, cache misses; -1 if unavailable
+    bool verified;
+};
+
+const char* const HARDWARE_COUNTER_NAMES[4] = {"cycles", "instructions", "branch_misses", "cache_misses"};
+
+// Hardware counters for the calling thread (and threads it starts) via perf_event_open
+class HardwareCounters {
+private:
+    int fds[4];
+
+public:
+    HardwareCounters() {
+        for (int i = 0; i < 4; ++i) fds[i] = -1;
+#ifdef __linux__
+        const unsigned long long configs[4] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                               PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES};
+        for (int i = 0; i < 4; ++i) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+#endif
+    }
+
+    ~HardwareCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    HardwareCounters(const HardwareCounters&) = delete;
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+    bool available() const { return fds[0] >= 0; }
+
+    void start() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Adds the counts since start() to totals[] (unavailable counters are left alone)
+    void stop(long long totals[4]) {
+#ifdef __linux__
+        for (int i = 0; i < 4; ++i) {
+            if (fds[i] < 0) continue;
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            long long value = 0;
+            if (read(fds[i], &value, sizeof(value)) == (ssize_t)sizeof(value)) {
+                totals[i] += value;
+            }
+        }
+#else
+        (void)totals;
+#endif
+    }
+
+    bool counterAvailable(int i) const { return fds[i] >= 0; }
+};
+
+const int ZIPF_DISTINCT_KEYS = 1 << 16;
+const double ZIPF_EXPONENT = 1.0;
+const int FEW_UNIQUE_KEYS = 16;
+
+void fillDistribution(vector<int>& data, const string& distribution, mt19937& rng) {
+    int n = (int)data.size();
+    if (distribution == "uniform") {
+        for (int i = 0; i < n; ++i) data[i] = (int)rng();
+    } else if (distribution == "zipf") {
+        // Rank k is drawn with probability proportional to 1 / k^s (inverse CDF lookup)
+        vector<double> cdf(ZIPF_DISTINCT_KEYS);
+        double total = 0;
+        for (int k = 0; k < ZIPF_DISTINCT_KEYS; ++k) {
+            total += 1.0 / pow(k + 1, ZIPF_EXPONENT);
+            cdf[k] = total;
+        }
+        uniform_real_distribution<double> unit(0.0, total);
+        for (int i = 0; i < n; ++i) {
+            data[i] = (int)(lower_bound(cdf.begin(), cdf.end(), unit(rng)) - cdf.begin());
+        }
+    } else if (distribution == "sorted") {
+        for (int i = 0; i < n; ++i) data[i] = i;
+    } else if (distribution == "reverse") {
+        for (int i = 0; i < n; ++i) data[i] = n - i;
+    } else if (distribution == "few-unique") {
+        for (int i = 0; i < n; ++i) data[i] = (int)(rng() % FEW_UNIQUE_KEYS);
+    } else if (distribution == "sawtooth") {
+        // About sqrt(n) ascending teeth
+        int period = max(2, (int)sqrt((double)n));
+        for (int i = 0; i < n; ++i) data[i] = i % period;
+    }
+}
+
+vector<string> splitList(const string& text) {
+    vector<string> items;
+    stringstream stream(text);
+    string item;
+    while (getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+// Nearest-rank percentile of an ascending sample
+double percentile(const vector<double>& sorted, double p) {
+    int rank = (int)ceil(p * sorted.size());
+    return sorted[max(0, min((int)sorted.size() - 1, rank - 1))];
+}
+
+BenchResult benchmarkCell(const SortAlgorithm& algo, const string& distribution, const vector<int>& input,
+                          const vector<int>& reference, int warmup, int reps, HardwareCounters& counters) {
+    int n = (int)input.size();
+    BenchResult result;
+    result.algorithm = algo.id;
+    result.distribution = distribution;
+    result.n = n;
+    result.reps = reps;
+    result.verified = true;
+
+    vector<int> work;
+    for (int w = 0; w < warmup; ++w) {
+        work = input;
+        algo.sortInts(work.data(), n);
+    }
+
+    vector<double> times;
+    long long hardwareTotals[4] = {0, 0, 0, 0};
+    for (int r = 0; r < reps; ++r) {
+        work = input;
+        counters.start();
+        auto start = chrono::steady_clock::now();
+        algo.sortInts(work.data(), n);
+        auto end = chrono::steady_clock::now();
+        counters.stop(hardwareTotals);
+        times.push_back(chrono::duration<double, milli>(end - start).count());
+        result.verified = result.verified && (work == reference);
+    }
+    sort(times.begin(), times.end());
+    int half = reps / 2;
+    result.medianMs = (reps % 2 == 1) ? times[half] : (times[half - 1] + times[half]) / 2;
+    result.p95Ms = percentile(times, 0.95);
+    result.nsPerElement = result.medianMs * 1e6 / max(1, n);
+    for (int i = 0; i < 4; ++i) {
+        result.hardware[i] = counters.counterAvailable(i) ? hardwareTotals[i] / reps : -1;
+    }
+
+    result.comparisons = result.moves = result.swaps = result.maxDepth = result.scratchBytes = -1;
+    if (algo.sortInstrumented != nullptr) {
+        work = input;
+        sortCounters.reset();
+        algo.sortInstrumented(work.data(), n);
+        result.verified = result.verified && (work == reference);
+        result.comparisons = sortCounters.comparisons;
+        result.moves = sortCounters.moves;
+        result.swaps = sortCounters.swaps;
+        result.maxDepth = sortCounters.maxDepth;
+        result.scratchBytes = sortCounters.scratchBytes;
+    }
+    return result;
+}
+
+void printBenchTableHeader(ostream& out) {
+    out << left << setw(20) << "algorithm" << setw(12) << "dist" << right << setw(10) << "n"
+        << setw(12) << "median ms" << setw(12) << "p95 ms" << setw(10) << "ns/elem"
+        << setw(15) << "comparisons" << setw(13) << "moves" << setw(12) << "swaps" << setw(7) << "depth"
+        << setw(12) << "scratch B" << setw(15) << "instructions"
+        << setw(13) << "br-misses" << "  ok" << endl;
+}
+
+void printBenchTableRow(ostream& out, const BenchResult& r) {
+    auto countText = [](long long value) { return value < 0 ? string("-") : to_string(value); };
+    out << left << setw(20) << r.algorithm << setw(12) << r.distribution << right << setw(10) << r.n
+        << fixed << setprecision(3) << setw(12) << r.medianMs << setw(12) << r.p95Ms
+        << setprecision(2) << setw(10) << r.nsPerElement << defaultfloat
+        << setw(15) << countText(r.comparisons) << setw(13) << countText(r.moves)
+        << setw(12) << countText(r.swaps) << setw(7) << countText(r.maxDepth) << setw(12) << countText(r.scratchBytes)
+        << setw(15) << countText(r.hardware[1]) << setw(13) << countText(r.hardware[2])
+        << "  " << (r.verified ? "yes" : "NO") << endl;
+}
+
+void writeBenchCsv(ostream& out, const vector<BenchResult>& results) {
+    out << "algorithm,distribution,n,reps,median_ms,p95_ms,ns_per_element,"
+        << "comparisons,moves,swaps,max_depth,scratch_bytes";
+    for (const char* name : HARDWARE_COUNTER_NAMES) out << "," << name;
+    out << ",verified\n";
+    // Unobservable counts are left empty
+    auto countText = [](long long value) { return value < 0 ? string() : to_string(value); };
+    for (const BenchResult& r : results) {
+        out << r.algorithm << "," << r.distribution << "," << r.n << "," << r.reps << ","
+            << r.medianMs << "," << r.p95Ms << "," << r.nsPerElement << ","
+            << countText(r.comparisons) << "," << countText(r.moves) << "," << countText(r.swaps) << ","
+            << countText(r.maxDepth) << "," << countText(r.scratchBytes);
+        for (long long value : r.hardware) out << "," << countText(value);
+        out << "," << (r.verified ? "true" : "false") << "\n";
+    }
+}
+
+void writeBenchJson(ostream& out, const vector<BenchResult>& results) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "  {\"algorithm\": \"" << r.algorithm << "\", \"distribution\": \"" << r.distribution
+            << "\", \"n\": " << r.n << ", \"reps\": " << r.reps
+            << ", \"median_ms\": " << r.medianMs << ", \"p95_ms\": " << r.p95Ms
+            << ", \"ns_per_element\": " << r.nsPerElement;
+        // Unobservable counts are emitted as null
+        auto field = [&](const char* name, long long value) {
+            out << ", \"" << name << "\": ";
+            if (value < 0) out << "null"; else out << value;
+        };
+        field("comparisons", r.comparisons);
+        field("moves", r.moves);
+        field("swaps", r.swaps);
+        field("max_depth", r.maxDepth);
+        field("scratch_bytes", r.scratchBytes);
+        for (int k = 0; k < 4; ++k) field(HARDWARE_COUNTER_NAMES[k], r.hardware[k]);
+        out << ", \"verified\": " << (r.verified ? "true" : "false") << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
+
+// Options: --sizes 1000,100000 --dists uniform,zipf --algos merge,introsort
+//          --reps 5 --warmup 1 --format table|csv|json --out results.csv
+bool parseBenchOptions(int argc, char* argv[], int first, BenchOptions& options) {
+    for (int i = first; i < argc; ++i) {
+        string flag = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Error: missing value for " << flag << endl;
+            return false;
+        }
+        string value = argv[++i];
+        if (flag == "--sizes") {
+            options.sizes.clear();
+            for (const string& size : splitList(value)) {
+                char* end = nullptr;
+                errno = 0;
+                long n = strtol(size.c_str(), &end, 10);
+                if (size.empty() || *end != '\0' || errno == ERANGE || n <= 0 || n > INT_MAX) {
+                    cerr << "Error: invalid size " << size << " (expected a positive integer)" << endl;
+                    return false;
+                }
+                options.sizes.push_back((int)n);
+            }
+            if (options.sizes.empty()) {
+                cerr << "Error: --sizes needs at least one size" << endl;
+                return false;
+            }
+        } else if (flag == "--dists") {
+            options.distributions = splitList(value);
+            for (const string& distribution : options.distributions) {
+                if (find(BENCH_DISTRIBUTIONS.begin(), BENCH_DISTRIBUTIONS.end(), distribution) == BENCH_DISTRIBUTIONS.end()) {
+                    cerr << "Error: unknown distribution " << distribution << " (known:";
+                    for (const string& known : BENCH_DISTRIBUTIONS) cerr << " " << known;
+                    cerr << ")" << endl;
+                    return false;
+                }
+            }
+        } else if (flag == "--algos") {
+            options.algorithms = splitList(value);
+            for (const string& id : options.algorithms) {
+                const vector<SortAlgorithm>& known = sortAlgorithms();
+                if (none_of(known.begin(), known.end(), [&](const SortAlgorithm& algo) { return algo.id == id; })) {
+                    cerr << "Error: unknown algorithm " << id << " (known:";
+                    for (const SortAlgorithm& algo : known) cerr << " " << algo.id;
+                    cerr << ")" << endl;
+                    return false;
+                }
+            }
+        } else if (flag == "--reps") {
+            options.reps = max(1, atoi(value.c_str()));
+        } else if (flag == "--warmup") {
+            options.warmup = max(0, atoi(value.c_str()));
+        } else if (flag == "--format") {
+            options.format = value;
+        } else if (flag == "--out") {
+            options.outputPath = value;
+        } else {
+            cerr << "Error: unknown benchmark option " << flag << endl;
+            return false;
+        }
+    }
+    if (options.format != "table" && options.format != "csv" && options.format != "json") {
+        cerr << "Error: --format must be table, csv or json" << endl;
+        return false;
+    }
+    return true;
+}
+
+bool runBenchmarkHarness(const BenchOptions& options) {
+    vector<const SortAlgorithm*> selected;
+    for (const SortAlgorithm& algo : sortAlgorithms()) {
+        if (options.algorithms.empty() ||
+            find(options.algorithms.begin(), options.algorithms.end(), algo.id) != options.algorithms.end()) {
+            selected.push_back(&algo);
+        }
+    }
+    if (selected.empty()) {
+        cerr << "Error: no registered sort matches --algos" << endl;
+        return false;
+    }
+
+    ofstream file;
+    if (!options.outputPath.empty()) {
+        file.open(options.outputPath);
+        if (!file) {
+            cerr << "Error: cannot open " << options.outputPath << endl;
+            return false;
+        }
+    }
+    ostream& out = options.outputPath.empty() ? cout : file;
+
+    HardwareCounters counters;
+    bool table = (options.format == "table");
+    if (table) {
+        out << "\n--- Sorting Benchmark (" << options.warmup << " warmup, " << options.reps
+            << " timed reps, hardware counters " << (counters.available() ? "on" : "unavailable") << ") ---" << endl;
+        printBenchTableHeader(out);
+    }
+
+    vector<BenchResult> results;
+    mt19937 rng(42);
+    for (int n : options.sizes) {
+        for (const string& distribution : options.distributions) {
+            vector<int> input(max(0, n));
+            fillDistribution(input, distribution, rng);
+            vector<int> reference = input;
+            sort(reference.begin(), reference.end());
+            for (const SortAlgorithm* algo : selected) {
+                if (n > algo->maxN) continue;
+                BenchResult result = benchmarkCell(*algo, distribution, input, reference,
+                                                   options.warmup, options.reps, counters);
+                if (table) printBenchTableRow(out, result);
+                results.push_back(result);
+            }
+        }
+    }
+
+    if (options.format == "csv") writeBenchCsv(out, results);
+    if (options.format == "json") writeBenchJson(out, results);
+    return true;
+}
+
+// ==========================================================
+// --- Top-k / Selection Benchmark (--bench-topk [n]) ---
+// ==========================================================
+
+void runTopKBenchmark(int n) {
+    cout << "\n--- Top-k Benchmark (n = " << n << ", uniform random ints) ---" << endl;
+    mt19937 rng(42);
+    vector<int> input(n);
+    for (int i = 0; i < n; ++i) input[i] = (int)rng();
+    vector<int> sortedInput = input;
+    sort(sortedInput.begin(), sortedInput.end());
+    vector<int> output;
+
+    double fullMs = timeSortMs(input, output, [](int* a, int len) { introSort(a, 0, len - 1); });
+    cout << "Full introsort: " << fullMs << " ms" << endl;
+
+    const int ks[] = {10, 100, 1000, 10000, 100000, n / 10};
+    for (int k : ks) {
+        if (k <= 0 || k > n) continue;
+        auto prefixOk = [&]() { return equal(output.begin(), output.begin() + k, sortedInput.begin()); };
+        double heapMs = timeSortMs(input, output, [k](int* a, int len) { partialSortHeap(a, len, k); });
+        bool ok = prefixOk();
+        double selectMs = timeSortMs(input, output, [k](int* a, int len) { partialSortSelect(a, len, k); });
+        ok = ok && prefixOk();
+        double autoMs = timeSortMs(input, output, [k](int* a, int len) { partialSort(a, len, k); });
+        ok = ok && prefixOk();
+        double stdMs = timeSortMs(input, output, [k](int* a, int len) { partial_sort(a, a + k, a + len); });
+
+        auto start = chrono::steady_clock::now();
+        StreamingTopK stream(k);
+        stream.push(input.data(), n);
+        vector<int> streamed = stream.sorted();
+        double streamMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        ok = ok && equal(streamed.begin(), streamed.end(), sortedInput.begin());
+
+        cout << "k = " << k << endl;
+        cout << "  partialSort (auto):         " << autoMs << " ms" << endl;
+        cout << "  bounded heap:               " << heapMs << " ms" << endl;
+        cout << "  select + sort prefix:       " << selectMs << " ms" << endl;
+        cout << "  streaming top-k:            " << streamMs << " ms" << endl;
+        cout << "  std::partial_sort:          " << stdMs << " ms" << endl;
+        cout << "  Results correct: " << (ok ? "Yes" : "No") << endl;
+    }
+
+    int median = n / 2;
+    double nthMs = timeSortMs(input, output, [median](int* a, int len) { nthElement(a, len, median); });
+    bool medianOk = (output[median] == sortedInput[median]);
+    double stdNthMs = timeSortMs(input, output, [median](int* a, int len) { nth_element(a, a + median, a + len); });
+    cout << "Median selection" << endl;
+    cout << "  nthElement (introselect):   " << nthMs << " ms" << endl;
+    cout << "  std::nth_element:           " << stdNthMs << " ms" << endl;
+    cout << "  Result correct: " << (medianOk ? "Yes" : "No") << endl;
+}
+
+// ==========================================================
+// --- Sort-by-Key Layout Benchmark (--bench-soa [n]) ---
+// ==========================================================
+
+// AoS: the payload travels inside the record. SoA: keys and payloads live in
+// separate arrays and only the keys take part in the sort.
+template <int PayloadBytes>
+struct PayloadBlock {
+    char bytes[PayloadBytes];
+};
+
+template <int PayloadBytes>
+struct KeyedRecord {
+    int key;
+    PayloadBlock<PayloadBytes> payload;
+};
+
+template <int PayloadBytes>
+void runLayoutBenchmark(int n, mt19937& rng) {
+    vector<int> keys(n);
+    for (int i = 0; i < n; ++i) keys[i] = (int)(rng() % (unsigned int)max(1, n / 4)); // Duplicates exercise stability
+    vector<PayloadBlock<PayloadBytes>> payloads(n);
+    vector<KeyedRecord<PayloadBytes>> records(n);
+    for (int i = 0; i < n; ++i) {
+        memset(payloads[i].bytes, 0, PayloadBytes);
+        memcpy(payloads[i].bytes, &i, sizeof(int)); // Original position, checked for stability
+        records[i].key = keys[i];
+        records[i].payload = payloads[i];
+    }
+    auto originalIndex = [](const PayloadBlock<PayloadBytes>& block) {
+        int index;
+        memcpy(&index, block.bytes, sizeof(int));
+        return index;
+    };
+    auto timeMs = [](const function<void()>& body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+
+    // Reference: stable order of original positions
+    vector<unsigned int> expected = sortPermutationByKey(keys.data(), n, BY_KEY_STABLE_MERGE);
+    bool ok = true;
+
+    auto aos = records;
+    double aosMergeMs = timeMs([&]() { mergeSort(aos.begin(), aos.end(), less<>(), &KeyedRecord<PayloadBytes>::key); });
+    for (int i = 0; i < n; ++i) ok = ok && originalIndex(aos[i].payload) == (int)expected[i];
+    aos = records;
+    double aosRadixMs = timeMs([&]() { radixSortByKey(aos.begin(), aos.end(), &KeyedRecord<PayloadBytes>::key); });
+    for (int i = 0; i < n; ++i) ok = ok && originalIndex(aos[i].payload) == (int)expected[i];
+    aos = records;
+    double aosStdMs = timeMs([&]() {
+        stable_sort(aos.begin(), aos.end(), [](const KeyedRecord<PayloadBytes>& a, const KeyedRecord<PayloadBytes>& b) {
+            return a.key < b.key;
+        });
+    });
+
+    auto soaKeys = keys;
+    auto soaPayloads = payloads;
+    double soaRadixMs = timeMs([&]() { sortByKey(soaKeys.data(), n, BY_KEY_STABLE_RADIX, soaPayloads.data()); });
+    for (int i = 0; i < n; ++i) ok = ok && originalIndex(soaPayloads[i]) == (int)expected[i];
+    soaKeys = keys;
+    soaPayloads = payloads;
+    double soaMergeMs = timeMs([&]() { sortByKey(soaKeys.data(), n, BY_KEY_STABLE_MERGE, soaPayloads.data()); });
+    for (int i = 0; i < n; ++i) ok = ok && originalIndex(soaPayloads[i]) == (int)expected[i];
+    double permutationMs = timeMs([&]() { sortPermutationByKey(keys.data(), n); });
+
+    cout << "payload " << PayloadBytes << " bytes" << endl;
+    cout << "  AoS mergeSort by key:        " << aosMergeMs << " ms" << endl;
+    cout << "  AoS radixSortByKey:          " << aosRadixMs << " ms" << endl;
+    cout << "  AoS std::stable_sort:        " << aosStdMs << " ms" << endl;
+    cout << "  SoA sortByKey (radix):       " << soaRadixMs << " ms" << endl;
+    cout << "  SoA sortByKey (merge):       " << soaMergeMs << " ms" << endl;
+    cout << "  Permutation index only:      " << permutationMs << " ms" << endl;
+    cout << "  Stable order verified: " << (ok ? "Yes" : "No") << endl;
+}
+
+void runSoaBenchmark(int n) {
+    cout << "\n--- Sort-by-Key Benchmark: SoA vs AoS (n = " << n << ") ---" << endl;
+    mt19937 rng(42);
+    runLayoutBenchmark<4>(n, rng);
+    runLayoutBenchmark<16>(n, rng);
+    runLayoutBenchmark<64>(n, rng);
+    runLayoutBenchmark<256>(n, rng);
+}
+
+int main(int argc, char* argv[]) {
+    selectNetworkKernel();
+
+    // Benchmark harness: Assignment7_Sorting --bench-all [--sizes ..] [--dists ..] [--algos ..]
+    //                    [--reps R] [--warmup W] [--format table|csv|json] [--out file]
+    if (argc > 1 && string(argv[1]) == "--bench-all") {
+        BenchOptions options;
+        if (!parseBenchOptions(argc, argv, 2, options)) return 1;
+        return runBenchmarkHarness(options) ? 0 : 1;
+    }
+    // Benchmark mode: Assignment7_Sorting --bench-merge [maxN]
+    if (argc > 1 && string(argv[1]) == "--bench-merge") {
+        long long maxN = (argc > 2) ? atoll(argv[2]) : 10000000LL;
+        runMergeSortBenchmark(maxN);
+        return 0;
+    }
+    // Benchmark mode: Assignment7_Sorting --bench-quick [n]
+    if (argc > 1 && string(argv[1]) == "--bench-quick") {
+        int n = (argc > 2) ? atoi(argv[2]) : 1000000;
+        runQuickSortBenchmark(n);
+        return 0;
+    }
+    // Benchmark mode: Assignment7_Sorting --bench-radix [n]
+    if (argc > 1 && string(argv[1]) == "--bench-radix") {
+        int n = (argc > 2) ? atoi(argv[2]) : 10000000;
+        runRadixSortBenchmark(n);
+        return 0;
+    }
+    // Benchmark mode: Assignment7_Sorting --bench-network
+    if (argc > 1 && string(argv[1]) == "--bench-network") {
+        runNetworkBenchmark();
+        return 0;
+    }
+    // Benchmark mode: Assignment7_Sorting --bench-sample [n] [maxThreads]
+    if (argc > 1 && string(argv[1]) == "--bench-sample") {
+        int n = (argc > 2) ? atoi(argv[2]) : 10000000;
+        int maxThreads = (argc > 3) ? atoi(argv[3]) : (int)thread::hardware_concurrency();
+        if (maxThreads < 1) maxThreads = 1;
+        runSampleSortBenchmark(n, maxThreads);
+        return 0;
+    }
+    // Benchmark mode: Assignment7_Sorting --bench-adaptive [n]
+    if (argc > 1 && string(argv[1]) == "--bench-adaptive") {
+        runAdaptiveSortBenchmark((argc > 2) ? atoi(argv[2]) : 10000000);
+        return 0;
+    }
+    // Benchmark mode: Assignment7_Sorting --bench-topk [n]
+    if (argc > 1 && string(argv[1]) == "--bench-topk") {
+        runTopKBenchmark((argc > 2) ? atoi(argv[2]) : 10000000);
+        return 0;
+    }
+    // Benchmark mode: Assignment7_Sorting --bench-soa [n]
+    if (argc > 1 && string(argv[1]) == "--bench-soa") {
+        runSoaBenchmark((argc > 2) ? atoi(argv[2]) : 1000000);
+        return 0;
+    }
+    // Benchmark mode: Assignment7_Sorting --bench-external [MB]
+    if (argc > 1 && string(argv[1]) == "--bench-external") {
+        runExternalSortBenchmark((argc > 2) ? atoi(argv[2]) : 64);
+        return 0;
+    }
+    // External sort mode: Assignment7_Sorting --external-sort <input> <output> [memoryMB]
+    if (argc > 3 && string(argv[1]) == "--external-sort") {
+        ExternalSortOptions options;
+        if (argc > 4) options.memoryBytes = (size_t)atoll(argv[4]) << 20;
+        return externalSortFile(argv[2], argv[3], options) ? 0 : 1;
+    }
+
+    int test_arr[] = {64, 25, 12, 22, 11, 75, 5, 33};
+    int n = sizeof(test_arr) / sizeof(test_arr[0]);
+
+    cout << "=======================================================" << endl;
+    cout << "  Lab Assignment 7: Sorting Techniques (Q1)" << endl;
     cout << "=======================================================" << endl;
 
     // Q1 Demos:
-    runSortDemo("Selection Sort (Q1a)", selectionSort, test_arr, n);
-    runSortDemo("Insertion Sort (Q1b)", insertionSort, test_arr, n);
-    runSortDemo("Bubble Sort (Q1c)", bubbleSort, test_arr, n);
+    runSortDemo("Selection Sort (Q1a)", selectionSort, test_arr, n, selectionSort<CountingSortStats>);
+    runSortDemo("Insertion Sort (Q1b)", insertionSort, test_arr, n, insertionSort<CountingSortStats>);
+    runSortDemo("Bubble Sort (Q1c)", bubbleSort, test_arr, n, bubbleSort<CountingSortStats>);
     
-    // Quick and Merge Sort wrappers are handled inside runSortDemo based on name
-    runSortDemo("Merge Sort (Q1d)", nullptr, test_arr, n);
-    runSortDemo("Quick Sort (Q1e)", nullptr, test_arr, n);
+    // Merge and Quick Sort take bounds, so they run through their int[] wrappers
+    runSortDemo("Merge Sort (Q1d)", mergeSortArray, test_arr, n, mergeSortArray<CountingSortStats>);
+    runSortDemo("Quick Sort (Q1e)", quickSortArray, test_arr, n, quickSortArray<CountingSortStats>);
+    runSortDemo("Introsort Quick Sort (Q1e, production mode)", introSortArray, test_arr, n);
+    runSortDemo("Block Partition Quick Sort (Q1e, branchless mode)", blockQuickSortArray, test_arr, n);
+    runSortDemo("Adaptive Powersort (natural runs + galloping)", naturalMergeSort, test_arr, n);
+
+    // Non-comparison sorts for integer keys
+    runSortDemo("LSD Radix Sort (8-bit digits)", radixSortLSD, test_arr, n);
+    runSortDemo("LSD Radix Sort (11-bit digits)", radixSortLSD11, test_arr, n);
+    runSortDemo("LSD Radix Sort (16-bit digits)", radixSortLSD16, test_arr, n);
+    runSortDemo("MSD American Flag Sort (in-place)", americanFlagSort, test_arr, n);
+    runSortDemo("Parallel Sample Sort (all cores)", parallelSampleSortAllCores, test_arr, n);
 
     cout << "\n=======================================================" << endl;
     cout << "  Improved Bidirectional Selection Sort (Q2)" << endl;
@@ -277,5 +3635,46 @@ int main() {
     
     printArray(arr_q2, n_q2, "Sorted (Q2)");
 
+    int arr_q2_counted[] = {64, 25, 12, 22, 11, 75, 5, 33};
+    sortCounters.reset();
+    improvedSelectionSort<CountingSortStats>(arr_q2_counted, n_q2);
+    printSortCounters(sortCounters);
+
+    cout << "\n=======================================================" << endl;
+    cout << "  Selection and Top-k (nthElement, partialSort)" << endl;
+    cout << "=======================================================" << endl;
+
+    int arr_select[] = {64, 25, 12, 22, 11, 75, 5, 33};
+    int n_select = sizeof(arr_select) / sizeof(arr_select[0]);
+    nthElement(arr_select, n_select, n_select / 2);
+    cout << "Median (nthElement, k = " << n_select / 2 << "): " << arr_select[n_select / 2] << endl;
+
+    int arr_partial[] = {64, 25, 12, 22, 11, 75, 5, 33};
+    partialSort(arr_partial, n_select, 3);
+    printArray(arr_partial, 3, "3 smallest (partialSort)");
+
+    StreamingTopK topK(3);
+    topK.push(test_arr, n);
+    vector<int> streamed = topK.sorted();
+    printArray(streamed.data(), (int)streamed.size(), "3 smallest (streaming)");
+
+    cout << "\n=======================================================" << endl;
+    cout << "  Sort-by-Key (SoA payload arrays)" << endl;
+    cout << "=======================================================" << endl;
+
+    int keys_soa[] = {3, 1, 2, 1, 3};
+    int ids_soa[] = {10, 20, 30, 40, 50};
+    double prices_soa[] = {3.5, 1.5, 2.5, 1.25, 3.75};
+    int n_soa = sizeof(keys_soa) / sizeof(keys_soa[0]);
+    vector<unsigned int> order_soa = sortPermutationByKey(keys_soa, n_soa);
+    cout << "Permutation index: ";
+    for (unsigned int index : order_soa) cout << index << " ";
+    cout << endl;
+    sortByKey(keys_soa, n_soa, BY_KEY_STABLE_RADIX, ids_soa, prices_soa);
+    printArray(keys_soa, n_soa, "Keys");
+    printArray(ids_soa, n_soa, "Ids (stable)");
+
+    runGenericSortDemo();
+
     return 0;
 }
@@ -1,4 +1,13 @@
 #include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <string>
+#include <cstdlib>
+#include "OutputSink.h"
 
 using namespace std;
 
@@ -30,33 +39,182 @@ struct TreeNode {
     int data;
     TreeNode* left;
     TreeNode* right;
+    int height; // Nodes on the longest downward path, a leaf has height 1
+    int size;   // Nodes in the subtree rooted here, used for rank/select
 
     // Constructor
-    TreeNode(int val) : data(val), left(nullptr), right(nullptr) {}
+    TreeNode(int val) : data(val), left(nullptr), right(nullptr), height(1), size(1) {}
 };
 
+// Balancing policy chosen when the tree is constructed:
+//   BALANCE_NONE: plain BST, sorted input degenerates into a list (height n)
+//   BALANCE_AVL:  AVL rotations after every insert/delete keep height <= 1.44 log2(n)
+enum TreeBalance { BALANCE_NONE, BALANCE_AVL };
+
+// Visiting order for BinarySearchTree::traverse
+enum TraversalOrder { PRE_ORDER, IN_ORDER, POST_ORDER };
+
+// Nodes are carved out of slabs owned by the tree instead of individual
+// new/delete calls. Slabs are reserved once and never grow, so node addresses
+// stay stable; a bulk load takes all of its nodes from one slab of exactly the
+// right size. Released nodes are threaded onto a free list through 'left'.
+const int TREE_NODE_SLAB_SIZE = 1024;
+
 class BinarySearchTree {
 private:
     TreeNode* root;
-
-    // Helper for Q3(a): Recursive insertion (no duplicates)
-    TreeNode* insertRecursive(TreeNode* node, int data) {
-        if (node == nullptr) {
-            return new TreeNode(data);
+    TreeBalance balance;
+    vector<vector<TreeNode>> slabs;
+    TreeNode* freeList;
+    int liveNodes;
+    vector<TreeNode**> pathScratch; // Reused by insert/delete for the root-to-node path
+
+    TreeNode* allocateNode(int data) {
+        liveNodes++;
+        if (freeList != nullptr) {
+            TreeNode* node = freeList;
+            freeList = node->left;
+            *node = TreeNode(data);
+            return node;
         }
+        if (slabs.empty() || slabs.back().size() == slabs.back().capacity()) {
+            slabs.emplace_back();
+            slabs.back().reserve(TREE_NODE_SLAB_SIZE);
+        }
+        slabs.back().emplace_back(data);
+        return &slabs.back().back();
+    }
+
+    void releaseNode(TreeNode* node) {
+        node->left = freeList;
+        freeList = node;
+        liveNodes--;
+    }
+
+    // Drops every node at once; the slabs go back to the system
+    void releaseAll() {
+        slabs.clear();
+        freeList = nullptr;
+        liveNodes = 0;
+        root = nullptr;
+    }
 
-        if (data < node->data) {
-            node->left = insertRecursive(node->left, data);
-        } else if (data > node->data) {
-            node->right = insertRecursive(node->right, data);
+    int nodeHeight(TreeNode* node) const {
+        return (node == nullptr) ? 0 : node->height;
+    }
+
+    int nodeSize(TreeNode* node) const {
+        return (node == nullptr) ? 0 : node->size;
+    }
+
+    // Recomputes the cached height and subtree size from the children
+    void updateSubtree(TreeNode* node) {
+        node->height = 1 + custom_max(nodeHeight(node->left), nodeHeight(node->right));
+        node->size = 1 + nodeSize(node->left) + nodeSize(node->right);
+    }
+
+    // Left child becomes the subtree root
+    TreeNode* rotateRight(TreeNode* node) {
+        TreeNode* pivot = node->left;
+        node->left = pivot->right;
+        pivot->right = node;
+        updateSubtree(node);
+        updateSubtree(pivot);
+        return pivot;
+    }
+
+    // Right child becomes the subtree root
+    TreeNode* rotateLeft(TreeNode* node) {
+        TreeNode* pivot = node->right;
+        node->right = pivot->left;
+        pivot->left = node;
+        updateSubtree(node);
+        updateSubtree(pivot);
+        return pivot;
+    }
+
+    // Refreshes the node's height and size on the way back up from insert/delete and,
+    // in AVL mode, restores |height(left) - height(right)| <= 1 with at most
+    // two rotations (single for LL/RR, double for LR/RL)
+    TreeNode* rebalance(TreeNode* node) {
+        updateSubtree(node);
+        if (balance != BALANCE_AVL) {
+            return node;
+        }
+        int skew = nodeHeight(node->left) - nodeHeight(node->right);
+        if (skew > 1) {
+            if (nodeHeight(node->left->left) < nodeHeight(node->left->right)) {
+                node->left = rotateLeft(node->left);
+            }
+            return rotateRight(node);
+        }
+        if (skew < -1) {
+            if (nodeHeight(node->right->right) < nodeHeight(node->right->left)) {
+                node->right = rotateRight(node->right);
+            }
+            return rotateLeft(node);
         }
-        // If data == node->data (duplicate), we do nothing
+        return node;
+    }
 
+    // Builds a perfectly balanced subtree over keys[lo..hi] (middle key as the
+    // root). Nodes are taken in pre-order from the slab, so a node's left child
+    // sits right after it in memory.
+    TreeNode* buildBalanced(const int keys[], int lo, int hi) {
+        if (lo > hi) {
+            return nullptr;
+        }
+        int mid = lo + (hi - lo) / 2;
+        TreeNode* node = allocateNode(keys[mid]);
+        node->left = buildBalanced(keys, lo, mid - 1);
+        node->right = buildBalanced(keys, mid + 1, hi);
+        updateSubtree(node);
         return node;
     }
 
-    // Helper for Q2(d/e) and Q3(b): Finds the node with the minimum value in a given tree
-    TreeNode* findMin(TreeNode* node) {
+    // Inserts sorted keys[lo..hi] middle-first, so even a plain BST stays shallow
+    void insertMiddleFirst(const int keys[], int lo, int hi) {
+        if (lo > hi) {
+            return;
+        }
+        int mid = lo + (hi - lo) / 2;
+        insert(keys[mid]);
+        insertMiddleFirst(keys, lo, mid - 1);
+        insertMiddleFirst(keys, mid + 1, hi);
+    }
+
+    // Appends every key in ascending order
+    void collectInOrder(vector<int>& keys) const {
+        forEach([&keys](int key) { keys.push_back(key); });
+    }
+
+    // Copies an ascending range into keys, dropping repeated keys. Returns false
+    // at the first key smaller than the one before it.
+    template <typename Iter>
+    static bool collectSorted(Iter first, Iter last, vector<int>& keys) {
+        for (; first != last; ++first) {
+            if (keys.empty() || *first > keys.back()) {
+                keys.push_back(*first);
+            } else if (*first < keys.back()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Replaces the tree with a balanced tree over strictly increasing keys
+    void rebuildFrom(const vector<int>& keys) {
+        releaseAll();
+        if (keys.empty()) {
+            return;
+        }
+        slabs.emplace_back();
+        slabs.back().reserve(keys.size());
+        root = buildBalanced(keys.data(), 0, (int)keys.size() - 1);
+    }
+
+    // Helper for Q2(c): Finds the node with the minimum value in a given tree
+    TreeNode* findMin(TreeNode* node) const {
         if (node == nullptr) return nullptr;
         while (node->left != nullptr) {
             node = node->left;
@@ -64,118 +222,230 @@ private:
         return node;
     }
 
-    // Helper for Q3(b): Recursive deletion
-    TreeNode* deleteRecursive(TreeNode* node, int key) {
+    // Walks back up a root-to-node chain of links (the root slot or a parent's
+    // child pointer), refreshing heights and sizes and rebalancing bottom-up. Rotations
+    // only rewrite the slot being visited, so the links above stay valid.
+    void rebalancePath(vector<TreeNode**>& links) {
+        for (size_t i = links.size(); i-- > 0;) {
+            if (*links[i] != nullptr) {
+                *links[i] = rebalance(*links[i]);
+            }
+        }
+    }
+
+    // Helper for Q3(a): Iterative insertion (no duplicates)
+    void insertIterative(int data) {
+        vector<TreeNode**>& links = pathScratch;
+        links.clear();
+        TreeNode** link = &root;
+        while (*link != nullptr) {
+            if (data == (*link)->data) {
+                return; // Duplicate, we do nothing
+            }
+            links.push_back(link);
+            link = (data < (*link)->data) ? &(*link)->left : &(*link)->right;
+        }
+        *link = allocateNode(data);
+        rebalancePath(links);
+    }
+
+    // Helper for Q3(b): Iterative deletion
+    void deleteIterative(int key) {
+        vector<TreeNode**>& links = pathScratch;
+        links.clear();
+        TreeNode** link = &root;
+        while (*link != nullptr && (*link)->data != key) {
+            links.push_back(link);
+            link = (key < (*link)->data) ? &(*link)->left : &(*link)->right;
+        }
+        TreeNode* node = *link;
         if (node == nullptr) {
-            return nullptr;
+            return; // Key not found
         }
+        links.push_back(link);
 
-        if (key < node->data) {
-            node->left = deleteRecursive(node->left, key);
-        } else if (key > node->data) {
-            node->right = deleteRecursive(node->right, key);
+        if (node->left != nullptr && node->right != nullptr) {
+            // Case 2: Node with two children. Replace with in-order successor (smallest in right subtree)
+            TreeNode** successorLink = &node->right;
+            while ((*successorLink)->left != nullptr) {
+                links.push_back(successorLink);
+                successorLink = &(*successorLink)->left;
+            }
+            TreeNode* successor = *successorLink;
+            node->data = successor->data; // Copy successor's content to this node
+            *successorLink = successor->right; // Unlink the successor (it has no left child)
+            releaseNode(successor);
         } else {
             // Case 1: Node with only one child or no child
-            if (node->left == nullptr) {
-                TreeNode* temp = node->right;
-                delete node;
-                return temp;
-            } else if (node->right == nullptr) {
-                TreeNode* temp = node->left;
-                delete node;
-                return temp;
+            *link = (node->left != nullptr) ? node->left : node->right;
+            releaseNode(node);
+        }
+        rebalancePath(links);
+    }
+
+    // Q1: Pre-order traversal (Node -> Left -> Right) with an explicit stack
+    template <typename Visitor>
+    void preOrderIterative(Visitor& visit) const {
+        vector<TreeNode*> pending;
+        if (root != nullptr) pending.push_back(root);
+        while (!pending.empty()) {
+            TreeNode* node = pending.back();
+            pending.pop_back();
+            visit(node->data);
+            if (node->right != nullptr) pending.push_back(node->right);
+            if (node->left != nullptr) pending.push_back(node->left);
+        }
+    }
+
+    // Q1: In-order traversal (Left -> Node -> Right - visits sorted elements in BST)
+    template <typename Visitor>
+    void inOrderIterative(Visitor& visit) const {
+        vector<TreeNode*> pending;
+        TreeNode* current = root;
+        while (current != nullptr || !pending.empty()) {
+            while (current != nullptr) {
+                pending.push_back(current);
+                current = current->left;
             }
+            current = pending.back();
+            pending.pop_back();
+            visit(current->data);
+            current = current->right;
+        }
+    }
 
-            // Case 2: Node with two children. Replace with in-order successor (smallest in right subtree)
-            TreeNode* temp = findMin(node->right);
-            node->data = temp->data; // Copy successor's content to this node
-            node->right = deleteRecursive(node->right, temp->data); // Delete the successor
+    // Q1: Post-order traversal (Left -> Right -> Node). A node is visited once
+    // its right subtree is empty or was the last subtree finished.
+    template <typename Visitor>
+    void postOrderIterative(Visitor& visit) const {
+        vector<TreeNode*> pending;
+        TreeNode* current = root;
+        TreeNode* lastVisited = nullptr;
+        while (current != nullptr || !pending.empty()) {
+            while (current != nullptr) {
+                pending.push_back(current);
+                current = current->left;
+            }
+            TreeNode* top = pending.back();
+            if (top->right != nullptr && top->right != lastVisited) {
+                current = top->right;
+            } else {
+                visit(top->data);
+                lastVisited = top;
+                pending.pop_back();
+            }
         }
-        return node;
     }
 
-    // Q1: Pre-order traversal (Node -> Left -> Right)
-    void preOrderRecursive(TreeNode* node) const {
-        if (node == nullptr) return;
-        cout << node->data << " ";
-        preOrderRecursive(node->left);
-        preOrderRecursive(node->right);
+    // Renders one traversal into the shared sink and ends the line
+    void printTraversal(TraversalOrder order, ostream& out) const {
+        OutputSink& sink = outputSink(out);
+        traverse(order, [&sink](int key) { sink.integer(key).character(' '); });
+        sink.character('\n');
+        sink.flush();
+        out.flush();
     }
 
-    // Q1: In-order traversal (Left -> Node -> Right - prints sorted elements in BST)
-    void inOrderRecursive(TreeNode* node) const {
-        if (node == nullptr) return;
-        inOrderRecursive(node->left);
-        cout << node->data << " ";
-        inOrderRecursive(node->right);
+public:
+    explicit BinarySearchTree(TreeBalance mode = BALANCE_NONE)
+        : root(nullptr), balance(mode), freeList(nullptr), liveNodes(0) {}
+
+    // Nodes point into the tree's own slabs, so a copy would share them
+    BinarySearchTree(const BinarySearchTree&) = delete;
+    BinarySearchTree& operator=(const BinarySearchTree&) = delete;
+
+    // Q3(a): Public interface for insertion
+    void insert(int data) {
+        insertIterative(data);
     }
 
-    // Q1: Post-order traversal (Left -> Right -> Node)
-    void postOrderRecursive(TreeNode* node) const {
-        if (node == nullptr) return;
-        postOrderRecursive(node->left);
-        postOrderRecursive(node->right);
-        cout << node->data << " ";
+    // Q3(b): Public interface for deletion
+    void deleteNode(int key) {
+        deleteIterative(key);
     }
 
-    // Q3(c): Calculates the maximum depth (Height) of the tree
-    int maxDepthRecursive(TreeNode* node) const {
-        if (node == nullptr) {
-            return 0;
+    // Replaces the contents with a perfectly balanced tree over a sorted range
+    // in O(n): no comparisons between keys, no rotations. Duplicates are
+    // dropped, like insert does. All nodes come from one contiguous block.
+    // Returns false and leaves the tree unchanged if the range is not sorted.
+    template <typename Iter>
+    bool buildFromSorted(Iter first, Iter last) {
+        vector<int> keys;
+        if (!collectSorted(first, last, keys)) {
+            return false;
         }
-        int leftDepth = maxDepthRecursive(node->left);
-        int rightDepth = maxDepthRecursive(node->right);
-        // Depth is 1 (for current node) plus the maximum of the two sub-tree depths
-        return 1 + custom_max(leftDepth, rightDepth);
+        rebuildFrom(keys);
+        return true;
     }
 
-    // Q3(d): Calculates the minimum depth of the tree (shortest path to a leaf)
-    int minDepthRecursive(TreeNode* node) const {
-        if (node == nullptr) {
-            return 0;
-        }
-        if (node->left == nullptr && node->right == nullptr) {
-            return 1; // Leaf node
+    bool buildFromSorted(const vector<int>& sorted) {
+        return buildFromSorted(sorted.begin(), sorted.end());
+    }
+
+    // Replaces the contents with the right-leaning chain that sorted inserts
+    // give a plain BST, built in O(n) instead of O(n^2) for worst-case tests.
+    // Returns false and leaves the tree unchanged for an AVL tree (a chain is
+    // not a valid AVL shape) or an unsorted range.
+    template <typename Iter>
+    bool buildChainFromSorted(Iter first, Iter last) {
+        vector<int> keys;
+        if (balance == BALANCE_AVL || !collectSorted(first, last, keys)) {
+            return false;
         }
-        if (node->left == nullptr) {
-            return 1 + minDepthRecursive(node->right);
+        releaseAll();
+        if (keys.empty()) {
+            return true;
         }
-        if (node->right == nullptr) {
-            return 1 + minDepthRecursive(node->left);
+        slabs.emplace_back();
+        slabs.back().reserve(keys.size());
+        TreeNode* below = nullptr;
+        for (size_t i = keys.size(); i-- > 0;) {
+            TreeNode* node = allocateNode(keys[i]);
+            node->right = below;
+            updateSubtree(node);
+            below = node;
         }
-        // Minimum depth is 1 + minimum of the two sub-tree depths
-        return 1 + custom_min(minDepthRecursive(node->left), minDepthRecursive(node->right));
+        root = below;
+        return true;
     }
 
-    // Q4: Helper function to check if a binary tree is a valid BST
-    bool isBST(TreeNode* node, int min_val, int max_val) const {
-        // Base case: An empty tree is a BST
-        if (node == nullptr) {
+    // Adds a sorted batch to the existing keys. A batch that is large next to
+    // the tree is merged with an in-order walk and rebuilt in O(n + m); a small
+    // one is inserted middle-first in O(m log n). Returns false and leaves the
+    // tree unchanged if the batch is not sorted.
+    template <typename Iter>
+    bool mergeSorted(Iter first, Iter last) {
+        vector<int> batch;
+        if (!collectSorted(first, last, batch)) {
+            return false;
+        }
+        if (batch.empty()) {
             return true;
         }
-
-        // Check if the current node's value is within the valid range
-        if (node->data <= min_val || node->data >= max_val) {
-            return false;
+        int logSize = 1;
+        while ((1 << logSize) < liveNodes) logSize++;
+        if ((long long)batch.size() * logSize < liveNodes) {
+            insertMiddleFirst(batch.data(), 0, (int)batch.size() - 1);
+            return true;
         }
 
-        // Recursively check the left subtree: max constraint becomes current node's data
-        // Recursively check the right subtree: min constraint becomes current node's data
-        return isBST(node->left, min_val, node->data) &&
-               isBST(node->right, node->data, max_val);
+        vector<int> existing;
+        existing.reserve(liveNodes);
+        collectInOrder(existing);
+        vector<int> merged;
+        merged.reserve(existing.size() + batch.size());
+        set_union(existing.begin(), existing.end(), batch.begin(), batch.end(), back_inserter(merged));
+        rebuildFrom(merged);
+        return true;
     }
 
-public:
-    BinarySearchTree() : root(nullptr) {}
-
-    // Q3(a): Public interface for insertion
-    void insert(int data) {
-        root = insertRecursive(root, data);
+    bool mergeSorted(const vector<int>& sorted) {
+        return mergeSorted(sorted.begin(), sorted.end());
     }
 
-    // Q3(b): Public interface for deletion
-    void deleteNode(int key) {
-        root = deleteRecursive(root, key);
+    // Number of keys currently stored
+    int size() const {
+        return liveNodes;
     }
 
     // Q2(a): Search for a given item (Recursive)
@@ -225,79 +495,720 @@ public:
         return findMin(root)->data;
     }
 
-    // Q2(d): In-order successor of a given node
-    int inOrderSuccessor(int key) const {
+    // Number of keys strictly less than key; found reports whether key is stored
+    int countBelow(int key, bool& found) const {
+        int below = 0;
+        found = false;
         TreeNode* current = root;
-        TreeNode* successor = nullptr;
-
         while (current != nullptr) {
             if (key < current->data) {
-                successor = current; // Possible successor
                 current = current->left;
             } else if (key > current->data) {
+                below += nodeSize(current->left) + 1; // Left subtree and this node are smaller
                 current = current->right;
-            } else { // Node found (current->data == key)
-                // If it has a right child, the successor is the minimum in the right subtree
-                if (current->right != nullptr) {
-                    return findMin(current->right)->data;
-                }
-                // Otherwise, the successor is the last stored 'successor' (ancestor)
-                return (successor != nullptr) ? successor->data : -1;
+            } else {
+                found = true;
+                return below + nodeSize(current->left);
             }
         }
-        return -1; // Key not found
+        return below;
     }
 
-    // Q2(e): In-order predecessor of a given node
-    int inOrderPredecessor(int key) const {
-        TreeNode* current = root;
-        TreeNode* predecessor = nullptr;
+    // Number of keys <= key, in O(height)
+    int rank(int key) const {
+        bool found;
+        int below = countBelow(key, found);
+        return found ? below + 1 : below;
+    }
 
-        while (current != nullptr) {
-            if (key > current->data) {
-                predecessor = current; // Possible predecessor
-                current = current->right;
-            } else if (key < current->data) {
+    // k-th smallest key (k = 1 is the minimum), -1 if k is out of range
+    int select(int k) const {
+        if (k < 1 || k > nodeSize(root)) return -1; // Indicate empty tree or error
+        TreeNode* current = root;
+        while (true) {
+            int leftSize = nodeSize(current->left);
+            if (k <= leftSize) {
                 current = current->left;
-            } else { // Node found (current->data == key)
-                // If it has a left child, the predecessor is the maximum in the left subtree
-                if (current->left != nullptr) {
-                    TreeNode* temp = current->left;
-                    while (temp->right != nullptr) {
-                        temp = temp->right;
-                    }
-                    return temp->data;
-                }
-                // Otherwise, the predecessor is the last stored 'predecessor' (ancestor)
-                return (predecessor != nullptr) ? predecessor->data : -1;
+            } else if (k == leftSize + 1) {
+                return current->data;
+            } else {
+                k -= leftSize + 1;
+                current = current->right;
             }
         }
-        return -1; // Key not found
+    }
+
+    // Number of keys in [lo, hi], from two rank queries
+    int countInRange(int lo, int hi) const {
+        if (lo > hi) return 0;
+        bool found;
+        return rank(hi) - countBelow(lo, found);
+    }
+
+    // Q2(d): In-order successor of a given node: the key ranked right after it
+    int inOrderSuccessor(int key) const {
+        bool found;
+        int below = countBelow(key, found);
+        if (!found) return -1; // Key not found
+        return select(below + 2); // -1 if key is the maximum
+    }
+
+    // Q2(e): In-order predecessor of a given node: the key ranked right before it
+    int inOrderPredecessor(int key) const {
+        bool found;
+        int below = countBelow(key, found);
+        if (!found) return -1; // Key not found
+        return select(below); // -1 if key is the minimum
     }
 
     // Q1: Public interfaces for traversals
-    void preOrder() const { preOrderRecursive(root); cout << endl; }
-    void inOrder() const { inOrderRecursive(root); cout << endl; }
-    void postOrder() const { postOrderRecursive(root); cout << endl; }
+    void preOrder(ostream& out = cout) const { printTraversal(PRE_ORDER, out); }
+    void inOrder(ostream& out = cout) const { printTraversal(IN_ORDER, out); }
+    void postOrder(ostream& out = cout) const { printTraversal(POST_ORDER, out); }
+
+    // Calls visit(key) for every key in the given order. Uses an explicit
+    // stack, so the depth of the tree never reaches the call stack.
+    template <typename Visitor>
+    void traverse(TraversalOrder order, Visitor visit) const {
+        if (order == PRE_ORDER) {
+            preOrderIterative(visit);
+        } else if (order == IN_ORDER) {
+            inOrderIterative(visit);
+        } else {
+            postOrderIterative(visit);
+        }
+    }
+
+    // Calls visit(key) for every key, ascending
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        inOrderIterative(visit);
+    }
+
+    // Bidirectional in-order iterator. Holds the root-to-node path, so ++ and --
+    // are amortized O(1) without parent pointers; end() is the empty path, and
+    // --end() is the maximum. Invalidated by insert/delete.
+    class Iterator {
+    private:
+        const BinarySearchTree* tree;
+        vector<TreeNode*> path;
+
+        void descendLeft(TreeNode* node) {
+            for (; node != nullptr; node = node->left) path.push_back(node);
+        }
+
+        void descendRight(TreeNode* node) {
+            for (; node != nullptr; node = node->right) path.push_back(node);
+        }
+
+        friend class BinarySearchTree;
+
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = int;
+        using difference_type = ptrdiff_t;
+        using pointer = const int*;
+        using reference = const int&;
+
+        Iterator() : tree(nullptr) {}
+        explicit Iterator(const BinarySearchTree* owner) : tree(owner) {}
+
+        reference operator*() const { return path.back()->data; }
+        pointer operator->() const { return &path.back()->data; }
+
+        Iterator& operator++() {
+            TreeNode* node = path.back();
+            if (node->right != nullptr) {
+                descendLeft(node->right);
+                return *this;
+            }
+            // Climb until we leave a left subtree
+            path.pop_back();
+            while (!path.empty() && path.back()->right == node) {
+                node = path.back();
+                path.pop_back();
+            }
+            return *this;
+        }
+
+        Iterator& operator--() {
+            if (path.empty()) {
+                descendRight(tree->root);
+                return *this;
+            }
+            TreeNode* node = path.back();
+            if (node->left != nullptr) {
+                descendRight(node->left);
+                return *this;
+            }
+            // Climb until we leave a right subtree
+            path.pop_back();
+            while (!path.empty() && path.back()->left == node) {
+                node = path.back();
+                path.pop_back();
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+        Iterator operator--(int) { Iterator old = *this; --*this; return old; }
+
+        bool operator==(const Iterator& other) const {
+            if (path.empty() || other.path.empty()) return path.empty() && other.path.empty();
+            return path.back() == other.path.back();
+        }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    Iterator begin() const {
+        Iterator it(this);
+        it.descendLeft(root);
+        return it;
+    }
+
+    Iterator end() const {
+        return Iterator(this);
+    }
+
+    // First key >= key, or end()
+    Iterator lowerBound(int key) const {
+        Iterator it(this);
+        size_t keep = 0; // Path length up to the best candidate so far
+        for (TreeNode* node = root; node != nullptr;) {
+            it.path.push_back(node);
+            if (node->data >= key) {
+                keep = it.path.size();
+                node = node->left;
+            } else {
+                node = node->right;
+            }
+        }
+        it.path.resize(keep);
+        return it;
+    }
+
+    // Calls visit(key) for every key in [lo, hi], ascending, in O(height + k)
+    template <typename Visitor>
+    void rangeScan(int lo, int hi, Visitor visit) const {
+        if (lo > hi) return;
+        for (Iterator it = lowerBound(lo); it != end() && *it <= hi; ++it) {
+            visit(*it);
+        }
+    }
 
-    // Q3(c): Public interface for maximum depth
+    // Q3(c): Maximum depth (Height) of the tree, kept in the root by insert/delete
     int maxDepth() const {
-        return maxDepthRecursive(root);
+        return nodeHeight(root);
     }
 
-    // Q3(d): Public interface for minimum depth
+    // Q3(d): Minimum depth (shortest path to a leaf), level by level: the first
+    // level that holds a leaf is the answer
     int minDepth() const {
-        return minDepthRecursive(root);
+        if (root == nullptr) {
+            return 0;
+        }
+        vector<TreeNode*> level(1, root);
+        vector<TreeNode*> nextLevel;
+        for (int depth = 1;; ++depth) {
+            nextLevel.clear();
+            for (TreeNode* node : level) {
+                if (node->left == nullptr && node->right == nullptr) {
+                    return depth; // Leaf node
+                }
+                if (node->left != nullptr) nextLevel.push_back(node->left);
+                if (node->right != nullptr) nextLevel.push_back(node->right);
+            }
+            level.swap(nextLevel);
+        }
     }
 
-    // Q4: Public interface to check if it's a BST
+    // Q4: Check if it's a BST: the in-order walk must be strictly increasing
     bool isBinarySearchTree() const {
-        // Use the custom minimum integer value for the initial min range
-        // Max range is set high enough to not interfere with typical int values
-        return isBST(root, CUSTOM_INT_MIN, 2147483647); 
+        bool valid = true;
+        bool first = true;
+        int previous = CUSTOM_INT_MIN;
+        forEach([&](int key) {
+            if (!first && key <= previous) valid = false;
+            previous = key;
+            first = false;
+        });
+        return valid;
+    }
+};
+
+// ==========================================================
+// B+-TREE ORDERED INDEX
+// (cache-friendly alternative backend to BinarySearchTree)
+// ==========================================================
+
+// Every node holds up to BPTREE_NODE_KEYS sorted keys in one contiguous,
+// cache-line-aligned block (64 ints = 256 bytes = four cache lines), so a
+// level costs a few sequential line fetches instead of one miss per key.
+// Values live only in the leaves, which are doubly linked for range scans,
+// successor and predecessor. Unused key slots hold INT_MAX, so the in-node
+// search can compare whole 8-lane blocks without masking the tail.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BST_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+const int BPTREE_NODE_KEYS = 64;
+const int BPTREE_MIN_KEYS = BPTREE_NODE_KEYS / 2;
+const int BPTREE_EMPTY_KEY = 2147483647; // Padding for unused key slots
+
+// Number of keys[0..n-1] strictly less than key (keys sorted, slots past n padded)
+int countKeysBelowScalar(const int* keys, int n, int key) {
+    int below = 0;
+    for (int i = 0; i < n; ++i) {
+        below += (keys[i] < key);
+    }
+    return below;
+}
+
+#ifdef BST_HAVE_X86_SIMD
+
+// Reads whole 8-key blocks: n is rounded up, padding never compares below key
+__attribute__((target("avx2")))
+int countKeysBelowAVX2(const int* keys, int n, int key) {
+    __m256i needle = _mm256_set1_epi32(key);
+    int below = 0;
+    for (int i = 0; i < n; i += 8) {
+        __m256i block = _mm256_load_si256((const __m256i*)(keys + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, block)));
+        below += __builtin_popcount(mask);
+    }
+    return below;
+}
+
+__attribute__((target("sse4.1")))
+int countKeysBelowSSE4(const int* keys, int n, int key) {
+    __m128i needle = _mm_set1_epi32(key);
+    int below = 0;
+    for (int i = 0; i < n; i += 4) {
+        __m128i block = _mm_load_si128((const __m128i*)(keys + i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(needle, block)));
+        below += __builtin_popcount(mask);
+    }
+    return below;
+}
+
+#endif
+
+// Runtime-selected kernel (scalar until selectSimdKernels() runs)
+int (*countKeysBelow)(const int*, int, int) = countKeysBelowScalar;
+const char* simdKernelName = "scalar";
+
+void selectSimdKernels() {
+#ifdef BST_HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        countKeysBelow = countKeysBelowAVX2;
+        simdKernelName = "AVX2";
+    } else if (__builtin_cpu_supports("sse4.1")) {
+        countKeysBelow = countKeysBelowSSE4;
+        simdKernelName = "SSE4.1";
+    }
+#endif
+}
+
+struct BPlusNode {
+    alignas(64) int keys[BPTREE_NODE_KEYS];
+    int count;
+    bool leaf;
+
+    BPlusNode(bool isLeaf) : count(0), leaf(isLeaf) {
+        for (int i = 0; i < BPTREE_NODE_KEYS; ++i) keys[i] = BPTREE_EMPTY_KEY;
+    }
+
+    // First slot whose key is >= key
+    int lowerBound(int key) const {
+        return countKeysBelow(keys, count, key);
+    }
+};
+
+struct BPlusLeaf : BPlusNode {
+    BPlusLeaf* prev;
+    BPlusLeaf* next;
+
+    BPlusLeaf() : BPlusNode(true), prev(nullptr), next(nullptr) {}
+};
+
+// children[i] holds keys in [keys[i-1], keys[i]): a separator is the smallest key of its right subtree
+struct BPlusInner : BPlusNode {
+    BPlusNode* children[BPTREE_NODE_KEYS + 1];
+
+    BPlusInner() : BPlusNode(false) {}
+
+    int childIndex(int key) const {
+        int pos = lowerBound(key);
+        return (pos < count && keys[pos] == key) ? pos + 1 : pos;
     }
 };
 
+class BPlusTree {
+private:
+    BPlusNode* root;
+    BPlusLeaf* firstLeaf;
+    BPlusLeaf* lastLeaf;
+    int height;
+    int keyCount;
+
+    BPlusLeaf* findLeaf(int key) const {
+        BPlusNode* node = root;
+        while (!node->leaf) {
+            const BPlusInner* inner = static_cast<const BPlusInner*>(node);
+            node = inner->children[inner->childIndex(key)];
+        }
+        return static_cast<BPlusLeaf*>(node);
+    }
+
+    // Inserts key below node. If node had to split, returns the new right
+    // sibling and stores the separator to push up in splitKey.
+    BPlusNode* insertInto(BPlusNode* node, int key, int& splitKey, bool& inserted) {
+        if (node->leaf) {
+            BPlusLeaf* leaf = static_cast<BPlusLeaf*>(node);
+            int pos = leaf->lowerBound(key);
+            if (pos < leaf->count && leaf->keys[pos] == key) {
+                return nullptr; // Duplicate, like BinarySearchTree::insert
+            }
+            inserted = true;
+            if (leaf->count < BPTREE_NODE_KEYS) {
+                for (int i = leaf->count; i > pos; --i) leaf->keys[i] = leaf->keys[i - 1];
+                leaf->keys[pos] = key;
+                leaf->count++;
+                return nullptr;
+            }
+            return splitLeaf(leaf, pos, key, splitKey);
+        }
+
+        BPlusInner* inner = static_cast<BPlusInner*>(node);
+        int index = inner->childIndex(key);
+        int childSplitKey = 0;
+        BPlusNode* right = insertInto(inner->children[index], key, childSplitKey, inserted);
+        if (right == nullptr) {
+            return nullptr;
+        }
+        if (inner->count < BPTREE_NODE_KEYS) {
+            for (int i = inner->count; i > index; --i) {
+                inner->keys[i] = inner->keys[i - 1];
+                inner->children[i + 1] = inner->children[i];
+            }
+            inner->keys[index] = childSplitKey;
+            inner->children[index + 1] = right;
+            inner->count++;
+            return nullptr;
+        }
+        return splitInner(inner, index, childSplitKey, right, splitKey);
+    }
+
+    // Full leaf plus one key: the lower half stays, the upper half moves to a new right leaf
+    BPlusNode* splitLeaf(BPlusLeaf* leaf, int pos, int key, int& splitKey) {
+        int merged[BPTREE_NODE_KEYS + 1];
+        for (int i = 0, j = 0; i <= BPTREE_NODE_KEYS; ++i) {
+            merged[i] = (i == pos) ? key : leaf->keys[j++];
+        }
+        BPlusLeaf* right = new BPlusLeaf();
+        int leftCount = (BPTREE_NODE_KEYS + 1) / 2;
+        for (int i = 0; i < BPTREE_NODE_KEYS; ++i) {
+            leaf->keys[i] = (i < leftCount) ? merged[i] : BPTREE_EMPTY_KEY;
+        }
+        leaf->count = leftCount;
+        for (int i = leftCount; i <= BPTREE_NODE_KEYS; ++i) {
+            right->keys[right->count++] = merged[i];
+        }
+
+        right->prev = leaf;
+        right->next = leaf->next;
+        if (leaf->next != nullptr) leaf->next->prev = right;
+        leaf->next = right;
+        if (lastLeaf == leaf) lastLeaf = right;
+
+        splitKey = right->keys[0];
+        return right;
+    }
+
+    // Full inner node plus one separator: the middle separator moves up to the parent
+    BPlusNode* splitInner(BPlusInner* inner, int index, int key, BPlusNode* child, int& splitKey) {
+        int mergedKeys[BPTREE_NODE_KEYS + 1];
+        BPlusNode* mergedChildren[BPTREE_NODE_KEYS + 2];
+        mergedChildren[0] = inner->children[0];
+        for (int i = 0, j = 0; i <= BPTREE_NODE_KEYS; ++i) {
+            if (i == index) {
+                mergedKeys[i] = key;
+                mergedChildren[i + 1] = child;
+            } else {
+                mergedKeys[i] = inner->keys[j];
+                mergedChildren[i + 1] = inner->children[j + 1];
+                ++j;
+            }
+        }
+
+        BPlusInner* right = new BPlusInner();
+        int middle = BPTREE_NODE_KEYS / 2;
+        for (int i = 0; i < BPTREE_NODE_KEYS; ++i) {
+            inner->keys[i] = (i < middle) ? mergedKeys[i] : BPTREE_EMPTY_KEY;
+        }
+        for (int i = 0; i <= middle; ++i) inner->children[i] = mergedChildren[i];
+        inner->count = middle;
+
+        for (int i = middle + 1; i <= BPTREE_NODE_KEYS; ++i) {
+            right->keys[right->count] = mergedKeys[i];
+            right->children[right->count] = mergedChildren[i];
+            right->count++;
+        }
+        right->children[right->count] = mergedChildren[BPTREE_NODE_KEYS + 1];
+
+        splitKey = mergedKeys[middle];
+        return right;
+    }
+
+    // Removes key below node and repairs any child left with fewer than BPTREE_MIN_KEYS keys.
+    // Separators are left as they are: they still bound both subtrees after a removal.
+    bool eraseFrom(BPlusNode* node, int key) {
+        if (node->leaf) {
+            int pos = node->lowerBound(key);
+            if (pos >= node->count || node->keys[pos] != key) {
+                return false;
+            }
+            for (int i = pos; i < node->count - 1; ++i) node->keys[i] = node->keys[i + 1];
+            node->count--;
+            node->keys[node->count] = BPTREE_EMPTY_KEY;
+            return true;
+        }
+
+        BPlusInner* inner = static_cast<BPlusInner*>(node);
+        int index = inner->childIndex(key);
+        bool removed = eraseFrom(inner->children[index], key);
+        if (removed && inner->children[index]->count < BPTREE_MIN_KEYS) {
+            repairUnderflow(inner, index);
+        }
+        return removed;
+    }
+
+    // Borrows one key from a sibling with spare keys, otherwise merges with a sibling
+    void repairUnderflow(BPlusInner* parent, int index) {
+        BPlusNode* left = (index > 0) ? parent->children[index - 1] : nullptr;
+        BPlusNode* right = (index < parent->count) ? parent->children[index + 1] : nullptr;
+
+        if (left != nullptr && left->count > BPTREE_MIN_KEYS) {
+            borrowFromLeft(parent, index);
+        } else if (right != nullptr && right->count > BPTREE_MIN_KEYS) {
+            borrowFromRight(parent, index);
+        } else if (left != nullptr) {
+            mergeChildren(parent, index - 1);
+        } else {
+            mergeChildren(parent, index);
+        }
+    }
+
+    void borrowFromLeft(BPlusInner* parent, int index) {
+        BPlusNode* child = parent->children[index];
+        BPlusNode* left = parent->children[index - 1];
+        if (child->leaf) {
+            for (int i = child->count; i > 0; --i) child->keys[i] = child->keys[i - 1];
+            child->keys[0] = left->keys[left->count - 1];
+            parent->keys[index - 1] = child->keys[0];
+        } else {
+            BPlusInner* innerChild = static_cast<BPlusInner*>(child);
+            BPlusInner* innerLeft = static_cast<BPlusInner*>(left);
+            for (int i = child->count; i > 0; --i) {
+                innerChild->keys[i] = innerChild->keys[i - 1];
+                innerChild->children[i + 1] = innerChild->children[i];
+            }
+            innerChild->children[1] = innerChild->children[0];
+            innerChild->keys[0] = parent->keys[index - 1];
+            innerChild->children[0] = innerLeft->children[left->count];
+            parent->keys[index - 1] = left->keys[left->count - 1];
+        }
+        child->count++;
+        left->count--;
+        left->keys[left->count] = BPTREE_EMPTY_KEY;
+    }
+
+    void borrowFromRight(BPlusInner* parent, int index) {
+        BPlusNode* child = parent->children[index];
+        BPlusNode* right = parent->children[index + 1];
+        if (child->leaf) {
+            child->keys[child->count] = right->keys[0];
+            for (int i = 0; i < right->count - 1; ++i) right->keys[i] = right->keys[i + 1];
+            parent->keys[index] = right->keys[0];
+        } else {
+            BPlusInner* innerChild = static_cast<BPlusInner*>(child);
+            BPlusInner* innerRight = static_cast<BPlusInner*>(right);
+            innerChild->keys[child->count] = parent->keys[index];
+            innerChild->children[child->count + 1] = innerRight->children[0];
+            parent->keys[index] = right->keys[0];
+            for (int i = 0; i < right->count - 1; ++i) {
+                innerRight->keys[i] = innerRight->keys[i + 1];
+                innerRight->children[i] = innerRight->children[i + 1];
+            }
+            innerRight->children[right->count - 1] = innerRight->children[right->count];
+        }
+        child->count++;
+        right->count--;
+        right->keys[right->count] = BPTREE_EMPTY_KEY;
+    }
+
+    // Folds children[index + 1] into children[index] and drops separator keys[index]
+    void mergeChildren(BPlusInner* parent, int index) {
+        BPlusNode* left = parent->children[index];
+        BPlusNode* right = parent->children[index + 1];
+        if (left->leaf) {
+            for (int i = 0; i < right->count; ++i) left->keys[left->count++] = right->keys[i];
+            BPlusLeaf* leftLeaf = static_cast<BPlusLeaf*>(left);
+            BPlusLeaf* rightLeaf = static_cast<BPlusLeaf*>(right);
+            leftLeaf->next = rightLeaf->next;
+            if (rightLeaf->next != nullptr) rightLeaf->next->prev = leftLeaf;
+            if (lastLeaf == rightLeaf) lastLeaf = leftLeaf;
+            delete rightLeaf;
+        } else {
+            BPlusInner* innerLeft = static_cast<BPlusInner*>(left);
+            BPlusInner* innerRight = static_cast<BPlusInner*>(right);
+            innerLeft->keys[left->count] = parent->keys[index];
+            for (int i = 0; i < right->count; ++i) {
+                innerLeft->keys[left->count + 1 + i] = innerRight->keys[i];
+                innerLeft->children[left->count + 1 + i] = innerRight->children[i];
+            }
+            innerLeft->children[left->count + 1 + right->count] = innerRight->children[right->count];
+            left->count += 1 + right->count;
+            delete innerRight;
+        }
+
+        for (int i = index; i < parent->count - 1; ++i) {
+            parent->keys[i] = parent->keys[i + 1];
+            parent->children[i + 1] = parent->children[i + 2];
+        }
+        parent->count--;
+        parent->keys[parent->count] = BPTREE_EMPTY_KEY;
+    }
+
+    void destroy(BPlusNode* node) {
+        if (!node->leaf) {
+            BPlusInner* inner = static_cast<BPlusInner*>(node);
+            for (int i = 0; i <= inner->count; ++i) destroy(inner->children[i]);
+            delete inner;
+        } else {
+            delete static_cast<BPlusLeaf*>(node);
+        }
+    }
+
+public:
+    BPlusTree() : height(1), keyCount(0) {
+        BPlusLeaf* leaf = new BPlusLeaf();
+        root = leaf;
+        firstLeaf = leaf;
+        lastLeaf = leaf;
+    }
+
+    ~BPlusTree() {
+        destroy(root);
+    }
+
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    // Same contract as BinarySearchTree::insert (duplicates are ignored)
+    void insert(int data) {
+        int splitKey = 0;
+        bool inserted = false;
+        BPlusNode* right = insertInto(root, data, splitKey, inserted);
+        if (right != nullptr) {
+            BPlusInner* newRoot = new BPlusInner();
+            newRoot->keys[0] = splitKey;
+            newRoot->children[0] = root;
+            newRoot->children[1] = right;
+            newRoot->count = 1;
+            root = newRoot;
+            height++;
+        }
+        if (inserted) keyCount++;
+    }
+
+    void deleteNode(int key) {
+        if (!eraseFrom(root, key)) {
+            return;
+        }
+        keyCount--;
+        if (!root->leaf && root->count == 0) {
+            BPlusInner* oldRoot = static_cast<BPlusInner*>(root);
+            root = oldRoot->children[0];
+            delete oldRoot;
+            height--;
+        }
+    }
+
+    bool search(int key) const {
+        const BPlusLeaf* leaf = findLeaf(key);
+        int pos = leaf->lowerBound(key);
+        return pos < leaf->count && leaf->keys[pos] == key;
+    }
+
+    int maxElement() const {
+        if (keyCount == 0) return -1; // Indicate empty tree or error
+        return lastLeaf->keys[lastLeaf->count - 1];
+    }
+
+    int minElement() const {
+        if (keyCount == 0) return -1; // Indicate empty tree or error
+        return firstLeaf->keys[0];
+    }
+
+    // Next larger key after an existing key, -1 if key is absent or the largest
+    int inOrderSuccessor(int key) const {
+        const BPlusLeaf* leaf = findLeaf(key);
+        int pos = leaf->lowerBound(key);
+        if (pos >= leaf->count || leaf->keys[pos] != key) return -1; // Key not found
+        if (pos + 1 < leaf->count) return leaf->keys[pos + 1];
+        return (leaf->next != nullptr) ? leaf->next->keys[0] : -1;
+    }
+
+    // Next smaller key before an existing key, -1 if key is absent or the smallest
+    int inOrderPredecessor(int key) const {
+        const BPlusLeaf* leaf = findLeaf(key);
+        int pos = leaf->lowerBound(key);
+        if (pos >= leaf->count || leaf->keys[pos] != key) return -1; // Key not found
+        if (pos > 0) return leaf->keys[pos - 1];
+        return (leaf->prev != nullptr) ? leaf->prev->keys[leaf->prev->count - 1] : -1;
+    }
+
+    // Calls visit(key) for every key in [lo, hi], ascending, by walking the leaf chain
+    template <typename Visitor>
+    void rangeScan(int lo, int hi, Visitor visit) const {
+        if (lo > hi) return;
+        const BPlusLeaf* leaf = findLeaf(lo);
+        int pos = leaf->lowerBound(lo);
+        while (leaf != nullptr) {
+            for (; pos < leaf->count; ++pos) {
+                if (leaf->keys[pos] > hi) return;
+                visit(leaf->keys[pos]);
+            }
+            leaf = leaf->next;
+            pos = 0;
+        }
+    }
+
+    // Calls visit(key) for every key, ascending
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (const BPlusLeaf* leaf = firstLeaf; leaf != nullptr; leaf = leaf->next) {
+            for (int i = 0; i < leaf->count; ++i) visit(leaf->keys[i]);
+        }
+    }
+
+    void inOrder(ostream& out = cout) const {
+        OutputSink& sink = outputSink(out);
+        forEach([&sink](int key) { sink.integer(key).character(' '); });
+        sink.character('\n');
+        sink.flush();
+        out.flush();
+    }
+
+    int size() const { return keyCount; }
+
+    // Levels from root to leaf (every leaf sits at the same depth)
+    int maxDepth() const { return height; }
+};
+
 // ==========================================================
 // HEAP AND HEAPSORT IMPLEMENTATION
 // (Q5, Q6)
@@ -489,14 +1400,17 @@ void printResult(const string& operation, int value) {
 
 // Utility to print an array
 void printArray(const int arr[], int n, const string& title) {
-    cout << title << ": [";
+    OutputSink& sink = outputSink();
+    sink.text(title).text(": [", 3);
     for (int i = 0; i < n; ++i) {
-        cout << arr[i];
+        sink.integer(arr[i]);
         if (i < n - 1) {
-            cout << ", ";
+            sink.text(", ", 2);
         }
     }
-    cout << "]" << endl;
+    sink.text("]\n", 2);
+    sink.flush();
+    cout.flush();
 }
 
 
@@ -556,6 +1470,395 @@ void runBSTDemo() {
     cout << "Is the current tree a BST? " << (bst.isBinarySearchTree() ? "Yes" : "No") << endl;
 }
 
+void runBalancedBSTDemo() {
+    cout << "\n--- 6. Self-Balancing Mode (AVL) ---" << endl;
+    BinarySearchTree plain;
+    BinarySearchTree avl(BALANCE_AVL);
+    for (int val = 1; val <= 15; ++val) {
+        plain.insert(val);
+        avl.insert(val);
+    }
+    cout << "Inserted 1..15 in ascending order" << endl;
+    printResult("Maximum Depth (plain BST)", plain.maxDepth());
+    printResult("Maximum Depth (AVL)", avl.maxDepth());
+    cout << "AVL Pre-order: "; avl.preOrder();
+    avl.deleteNode(8);
+    cout << "AVL In-order after deleting 8: "; avl.inOrder();
+    printResult("In-order Successor of 7 (AVL)", avl.inOrderSuccessor(7));
+    printResult("In-order Predecessor of 9 (AVL)", avl.inOrderPredecessor(9));
+    cout << "Is the AVL tree a BST? " << (avl.isBinarySearchTree() ? "Yes" : "No") << endl;
+}
+
+// ==========================================================
+// --- Balanced vs Plain BST Benchmark (--bench-balance [n]) ---
+// ==========================================================
+
+// Written by the benchmark so the measured loops cannot be optimized away
+volatile long long benchmarkSink = 0;
+
+void runTreeBenchmark(const string& label, TreeBalance mode, const vector<int>& keys, const vector<int>& probes) {
+    BinarySearchTree tree(mode);
+    auto start = chrono::steady_clock::now();
+    for (int key : keys) tree.insert(key);
+    auto afterInsert = chrono::steady_clock::now();
+
+    long long found = 0;
+    for (int key : probes) {
+        if (tree.searchNonRecursive(key) != nullptr) ++found;
+        found += tree.inOrderSuccessor(key);
+    }
+    auto afterSearch = chrono::steady_clock::now();
+
+    int depth = tree.maxDepth();
+    for (size_t i = 0; i < keys.size(); i += 2) tree.deleteNode(keys[i]);
+    auto afterDelete = chrono::steady_clock::now();
+    benchmarkSink = found;
+
+    cout << "  " << label << endl;
+    cout << "    insert:                " << chrono::duration<double, milli>(afterInsert - start).count() << " ms" << endl;
+    cout << "    search + successor:    " << chrono::duration<double, milli>(afterSearch - afterInsert).count() << " ms" << endl;
+    cout << "    delete half:           " << chrono::duration<double, milli>(afterDelete - afterSearch).count() << " ms" << endl;
+    cout << "    height after insert:   " << depth << endl;
+    cout << "    height after delete:   " << tree.maxDepth()
+         << ", still a BST: " << (tree.isBinarySearchTree() ? "Yes" : "No") << endl;
+}
+
+void runBalanceBenchmark(int n) {
+    cout << "\n--- BST Benchmark: plain vs AVL (n = " << n << ") ---" << endl;
+    mt19937 rng(42);
+    vector<int> sortedKeys(n);
+    for (int i = 0; i < n; ++i) sortedKeys[i] = i * 2;
+    vector<int> randomKeys = sortedKeys;
+    shuffle(randomKeys.begin(), randomKeys.end(), rng);
+    vector<int> probes(n);
+    for (int i = 0; i < n; ++i) probes[i] = (int)(rng() % (unsigned int)(2 * n)); // Half hit, half miss
+
+    cout << "Sorted keys" << endl;
+    runTreeBenchmark("plain BST", BALANCE_NONE, sortedKeys, probes);
+    runTreeBenchmark("AVL", BALANCE_AVL, sortedKeys, probes);
+    cout << "Random keys" << endl;
+    runTreeBenchmark("plain BST", BALANCE_NONE, randomKeys, probes);
+    runTreeBenchmark("AVL", BALANCE_AVL, randomKeys, probes);
+}
+
+void runBPlusTreeDemo() {
+    cout << "\n--- 7. B+-Tree Ordered Index (" << simdKernelName << " node search) ---" << endl;
+    BPlusTree index;
+    for (int val = 1; val <= 200; ++val) {
+        index.insert(val * 5);
+    }
+    cout << "Inserted 5, 10, ..., 1000 (" << index.size() << " keys, "
+         << BPTREE_NODE_KEYS << " keys per node)" << endl;
+    printResult("Tree Height", index.maxDepth());
+    cout << "Search for 500: " << (index.search(500) ? "Found" : "Not Found") << endl;
+    cout << "Search for 501: " << (index.search(501) ? "Found" : "Not Found") << endl;
+    printResult("Maximum Element", index.maxElement());
+    printResult("Minimum Element", index.minElement());
+    printResult("In-order Successor of 320", index.inOrderSuccessor(320));
+    printResult("In-order Predecessor of 325", index.inOrderPredecessor(325));
+    for (int val = 5; val <= 900; val += 5) {
+        index.deleteNode(val);
+    }
+    cout << "In-order after deleting 5..900: "; index.inOrder();
+    cout << "Range scan [910, 950]: ";
+    index.rangeScan(910, 950, [](int key) { cout << key << " "; });
+    cout << endl;
+}
+
+void runBulkLoadDemo() {
+    cout << "\n--- 8. Bulk Load and Sorted Merge ---" << endl;
+    vector<int> dump;
+    for (int val = 10; val <= 150; val += 10) dump.push_back(val);
+    BinarySearchTree bst;
+    bst.buildFromSorted(dump);
+    cout << "buildFromSorted(10, 20, ..., 150) -> " << bst.size() << " keys" << endl;
+    printResult("Maximum Depth", bst.maxDepth());
+    cout << "Pre-order: "; bst.preOrder();
+    vector<int> batch = {5, 25, 35, 155, 160};
+    bst.mergeSorted(batch);
+    cout << "In-order after mergeSorted(5, 25, 35, 155, 160): "; bst.inOrder();
+    printResult("Maximum Depth", bst.maxDepth());
+    cout << "Is the merged tree a BST? " << (bst.isBinarySearchTree() ? "Yes" : "No") << endl;
+    vector<int> unsorted = {170, 165, 180};
+    cout << "mergeSorted(170, 165, 180) accepted? " << (bst.mergeSorted(unsorted) ? "Yes" : "No")
+         << " (" << bst.size() << " keys)" << endl;
+}
+
+void runTraversalAPIDemo() {
+    cout << "\n--- 9. Visitors, Iterator and Range Queries ---" << endl;
+    BinarySearchTree bst(BALANCE_AVL);
+    int elements[] = {50, 30, 70, 20, 40, 60, 80, 35, 65};
+    for (int val : elements) {
+        bst.insert(val);
+    }
+    long long sum = 0;
+    bst.traverse(POST_ORDER, [&sum](int key) { sum += key; });
+    cout << "Sum of keys (post-order visitor): " << sum << endl;
+    cout << "Forward iterator: ";
+    for (BinarySearchTree::Iterator it = bst.begin(); it != bst.end(); ++it) cout << *it << " ";
+    cout << endl;
+    cout << "Backward iterator: ";
+    for (BinarySearchTree::Iterator it = bst.end(); it != bst.begin();) cout << *--it << " ";
+    cout << endl;
+    cout << "Range query [33, 66]: ";
+    bst.rangeScan(33, 66, [](int key) { cout << key << " "; });
+    cout << endl;
+}
+
+void runOrderStatisticsDemo() {
+    cout << "\n--- 10. Order Statistics (rank, select, range count) ---" << endl;
+    BinarySearchTree bst(BALANCE_AVL);
+    int elements[] = {50, 30, 70, 20, 40, 60, 80, 35, 65};
+    for (int val : elements) {
+        bst.insert(val);
+    }
+    printResult("rank(45) (keys <= 45)", bst.rank(45));
+    printResult("select(1) (minimum)", bst.select(1));
+    printResult("select(5) (median)", bst.select(5));
+    printResult("countInRange(33, 66)", bst.countInRange(33, 66));
+    bst.deleteNode(40);
+    cout << "Deleting element 40..." << endl;
+    printResult("rank(45) (keys <= 45)", bst.rank(45));
+    printResult("select(5)", bst.select(5));
+    printResult("In-order Successor of 35", bst.inOrderSuccessor(35));
+    printResult("In-order Predecessor of 50", bst.inOrderPredecessor(50));
+}
+
+// ==========================================================
+// --- Order Statistics Benchmark (--bench-rank [n]) ---
+// ==========================================================
+
+void runRankBenchmark(int n) {
+    cout << "\n--- Order Statistics Benchmark (n = " << n << " random keys, AVL) ---" << endl;
+    mt19937 rng(42);
+    BinarySearchTree bst(BALANCE_AVL);
+    for (int i = 0; i < n; ++i) bst.insert((int)(rng() % (unsigned int)(4 * n)));
+    const int queries = 200;
+    vector<int> probes(queries);
+    for (int& key : probes) key = (int)(rng() % (unsigned int)(4 * n));
+
+    auto timeMs = [](const function<void()>& body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+
+    // Reference: answer every query with a full in-order walk
+    vector<int> walkRank(queries);
+    vector<int> walkSelect(queries);
+    vector<int> walkCount(queries);
+    double walkMs = timeMs([&]() {
+        for (int q = 0; q < queries; ++q) {
+            int key = probes[q];
+            int k = 1 + q * (bst.size() / queries);
+            int position = 0;
+            int lessOrEqual = 0;
+            int inRange = 0;
+            walkSelect[q] = -1;
+            bst.forEach([&](int value) {
+                if (value <= key) lessOrEqual++;
+                if (value >= key && value <= key + n) inRange++;
+                if (++position == k) walkSelect[q] = value;
+            });
+            walkRank[q] = lessOrEqual;
+            walkCount[q] = inRange;
+        }
+    });
+
+    bool ok = true;
+    double treeMs = timeMs([&]() {
+        for (int q = 0; q < queries; ++q) {
+            int key = probes[q];
+            int k = 1 + q * (bst.size() / queries);
+            ok = ok && bst.rank(key) == walkRank[q];
+            ok = ok && bst.select(k) == walkSelect[q];
+            ok = ok && bst.countInRange(key, key + n) == walkCount[q];
+        }
+    });
+    cout << queries << " x (rank + select + countInRange)" << endl;
+    cout << "  full in-order walk:      " << walkMs << " ms" << endl;
+    cout << "  subtree sizes:           " << treeMs << " ms" << endl;
+    cout << "  Results match: " << (ok ? "Yes" : "No") << endl;
+}
+
+// ==========================================================
+// --- Degenerate Tree Traversal Check (--bench-traversal [n]) ---
+// ==========================================================
+
+// Sorted keys in a plain BST give a chain n nodes deep. Every traversal,
+// depth query, validation and delete below runs with explicit stacks, so the
+// chain depth never reaches the call stack. The chain is linked directly in
+// O(n); building it by sorted insert would be O(n^2).
+const int TRAVERSAL_BENCH_DEEP_DELETES = 10;
+
+void runTraversalBenchmark(int n) {
+    cout << "\n--- Traversal Benchmark (degenerate chain of n = " << n << " nodes) ---" << endl;
+    auto timeMs = [](const function<void()>& body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+
+    vector<int> keys(n);
+    for (int i = 0; i < n; ++i) keys[i] = i;
+    BinarySearchTree chain;
+    double buildMs = timeMs([&]() { chain.buildChainFromSorted(keys.begin(), keys.end()); });
+    cout << "Build chain from sorted keys: " << buildMs << " ms, height " << chain.maxDepth() << endl;
+
+    long long sum = 0;
+    const char* labels[] = {"pre-order visitor:        ", "in-order visitor:         ", "post-order visitor:       "};
+    TraversalOrder orders[] = {PRE_ORDER, IN_ORDER, POST_ORDER};
+    for (int i = 0; i < 3; ++i) {
+        double ms = timeMs([&]() { chain.traverse(orders[i], [&sum](int key) { sum += key; }); });
+        cout << "  " << labels[i] << ms << " ms" << endl;
+    }
+    double forwardMs = timeMs([&]() { for (int key : chain) sum += key; });
+    double backwardMs = timeMs([&]() {
+        for (BinarySearchTree::Iterator it = chain.end(); it != chain.begin();) sum += *--it;
+    });
+    double rangeMs = timeMs([&]() { chain.rangeScan(n / 4, n / 2, [&sum](int key) { sum += key; }); });
+    cout << "  iterator forward:         " << forwardMs << " ms" << endl;
+    cout << "  iterator backward:        " << backwardMs << " ms" << endl;
+    cout << "  range query [n/4, n/2]:   " << rangeMs << " ms" << endl;
+
+    int minDepth = 0;
+    bool valid = false;
+    double checkMs = timeMs([&]() {
+        minDepth = chain.minDepth();
+        valid = chain.isBinarySearchTree();
+    });
+    cout << "  minDepth + isBST:         " << checkMs << " ms (minDepth " << minDepth
+         << ", valid " << (valid ? "Yes" : "No") << ")" << endl;
+    // Each deepest delete walks the whole chain; the rest come off the root
+    int deepDeletes = custom_min(n, TRAVERSAL_BENCH_DEEP_DELETES);
+    double deepMs = timeMs([&]() { for (int i = n - 1; i >= n - deepDeletes; --i) chain.deleteNode(i); });
+    cout << "  delete " << deepDeletes << " deepest:        " << deepMs << " ms" << endl;
+    double deleteMs = timeMs([&]() { for (int i = 0; i < n - deepDeletes; ++i) chain.deleteNode(i); });
+    cout << "  delete rest from root:    " << deleteMs << " ms, " << chain.size() << " keys left" << endl;
+    benchmarkSink = sum;
+}
+
+// ==========================================================
+// --- Bulk Load Benchmark (--bench-bulk [n]) ---
+// ==========================================================
+
+void runBulkLoadBenchmark(int n) {
+    cout << "\n--- Bulk Load Benchmark (n = " << n << " sorted keys, batch = n / 4) ---" << endl;
+    vector<int> dump(n);
+    for (int i = 0; i < n; ++i) dump[i] = i * 4;
+    vector<int> batch(n / 4);
+    for (int i = 0; i < n / 4; ++i) batch[i] = i * 16 + 2; // Interleaves with the dump
+
+    auto timeMs = [](const function<void()>& body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+
+    BinarySearchTree inserted(BALANCE_AVL);
+    double insertMs = timeMs([&]() { for (int key : dump) inserted.insert(key); });
+    BinarySearchTree built;
+    double buildMs = timeMs([&]() { built.buildFromSorted(dump); });
+    cout << "Initial load" << endl;
+    cout << "  AVL insert one by one:   " << insertMs << " ms, height " << inserted.maxDepth() << endl;
+    cout << "  buildFromSorted:         " << buildMs << " ms, height " << built.maxDepth() << endl;
+
+    double insertBatchMs = timeMs([&]() { for (int key : batch) inserted.insert(key); });
+    double mergeMs = timeMs([&]() { built.mergeSorted(batch); });
+    cout << "Sorted batch" << endl;
+    cout << "  AVL insert one by one:   " << insertBatchMs << " ms, height " << inserted.maxDepth() << endl;
+    cout << "  mergeSorted:             " << mergeMs << " ms, height " << built.maxDepth() << endl;
+
+    bool ok = built.size() == inserted.size() && built.isBinarySearchTree();
+    for (int i = 0; ok && i < n; i += 997) {
+        ok = built.searchNonRecursive(dump[i]) != nullptr;
+    }
+    cout << "  Same keys in both trees: " << (ok ? "Yes" : "No") << endl;
+}
+
+// ==========================================================
+// --- B+-Tree vs Pointer BST Benchmark (--bench-bplus [n]) ---
+// ==========================================================
+
+struct IndexTimings {
+    double insertMs;
+    double searchMs;
+    double successorMs;
+    double deleteMs;
+    int height;
+};
+
+template <typename Index, typename Contains>
+IndexTimings timeIndex(Index& index, Contains contains, const vector<int>& keys, const vector<int>& probes) {
+    IndexTimings timings;
+    auto start = chrono::steady_clock::now();
+    for (int key : keys) index.insert(key);
+    auto afterInsert = chrono::steady_clock::now();
+
+    long long found = 0;
+    for (int key : probes) {
+        if (contains(index, key)) ++found;
+    }
+    auto afterSearch = chrono::steady_clock::now();
+    for (int key : probes) found += index.inOrderSuccessor(key);
+    auto afterSuccessor = chrono::steady_clock::now();
+
+    timings.height = index.maxDepth();
+    for (size_t i = 0; i < keys.size(); i += 2) index.deleteNode(keys[i]);
+    auto afterDelete = chrono::steady_clock::now();
+    benchmarkSink = found;
+
+    timings.insertMs = chrono::duration<double, milli>(afterInsert - start).count();
+    timings.searchMs = chrono::duration<double, milli>(afterSearch - afterInsert).count();
+    timings.successorMs = chrono::duration<double, milli>(afterSuccessor - afterSearch).count();
+    timings.deleteMs = chrono::duration<double, milli>(afterDelete - afterSuccessor).count();
+    return timings;
+}
+
+void printIndexTimings(const string& label, const IndexTimings& timings) {
+    cout << "  " << label << endl;
+    cout << "    insert:                " << timings.insertMs << " ms" << endl;
+    cout << "    search:                " << timings.searchMs << " ms" << endl;
+    cout << "    successor:             " << timings.successorMs << " ms" << endl;
+    cout << "    delete half:           " << timings.deleteMs << " ms" << endl;
+    cout << "    height:                " << timings.height << endl;
+}
+
+void runBPlusBenchmark(int n) {
+    cout << "\n--- Ordered Index Benchmark: B+-tree vs pointer BST (n = " << n
+         << ", " << simdKernelName << " node search) ---" << endl;
+    mt19937 rng(42);
+    vector<int> keys(n);
+    for (int i = 0; i < n; ++i) keys[i] = i * 2;
+    shuffle(keys.begin(), keys.end(), rng);
+    vector<int> probes(n);
+    for (int i = 0; i < n; ++i) probes[i] = keys[rng() % (unsigned int)n] + (int)(rng() & 1); // Half hit, half miss
+
+    // Each index is built and torn down in turn, so only one is resident at a time
+    {
+        BinarySearchTree tree;
+        printIndexTimings("plain BST (random order)", timeIndex(tree,
+            [](const BinarySearchTree& t, int key) { return t.searchNonRecursive(key) != nullptr; }, keys, probes));
+    }
+    {
+        BinarySearchTree tree(BALANCE_AVL);
+        printIndexTimings("AVL BST", timeIndex(tree,
+            [](const BinarySearchTree& t, int key) { return t.searchNonRecursive(key) != nullptr; }, keys, probes));
+    }
+    {
+        BPlusTree index;
+        IndexTimings timings = timeIndex(index, [](const BPlusTree& t, int key) { return t.search(key); }, keys, probes);
+        printIndexTimings("B+-tree", timings);
+
+        long long sum = 0;
+        auto start = chrono::steady_clock::now();
+        index.forEach([&sum](int key) { sum += key; });
+        auto end = chrono::steady_clock::now();
+        benchmarkSink = sum;
+        cout << "    ordered scan (leaves): " << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+    }
+}
+
 void runHeapDemo() {
     int arr_size = 8;
     int arr[] = {4, 1, 3, 2, 16, 9, 10, 14};
@@ -602,12 +1905,46 @@ void runHeapDemo() {
     printResult("Extract Max (After insertion)", max_pq.extractMax()); 
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    selectSimdKernels();
+
+    // Benchmark mode: Assignment8 --bench-balance [n]
+    // (kept moderate by default: the plain BST is O(n^2) on sorted keys)
+    if (argc > 1 && string(argv[1]) == "--bench-balance") {
+        runBalanceBenchmark((argc > 2) ? atoi(argv[2]) : 20000);
+        return 0;
+    }
+    // Benchmark mode: Assignment8 --bench-rank [n]
+    if (argc > 1 && string(argv[1]) == "--bench-rank") {
+        runRankBenchmark((argc > 2) ? atoi(argv[2]) : 1000000);
+        return 0;
+    }
+    // Benchmark mode: Assignment8 --bench-traversal [n]
+    if (argc > 1 && string(argv[1]) == "--bench-traversal") {
+        runTraversalBenchmark((argc > 2) ? atoi(argv[2]) : 1000000);
+        return 0;
+    }
+    // Benchmark mode: Assignment8 --bench-bulk [n]
+    if (argc > 1 && string(argv[1]) == "--bench-bulk") {
+        runBulkLoadBenchmark((argc > 2) ? atoi(argv[2]) : 4000000);
+        return 0;
+    }
+    // Benchmark mode: Assignment8 --bench-bplus [n]
+    if (argc > 1 && string(argv[1]) == "--bench-bplus") {
+        runBPlusBenchmark((argc > 2) ? atoi(argv[2]) : 10000000);
+        return 0;
+    }
+
     cout << "=======================================================" << endl;
     cout << "  Lab Assignment 8: Binary Search Trees & Heap" << endl;
     cout << "  (Using iostream only)" << endl;
     cout << "=======================================================" << endl;
     runBSTDemo();
+    runBalancedBSTDemo();
+    runBPlusTreeDemo();
+    runBulkLoadDemo();
+    runTraversalAPIDemo();
+    runOrderStatisticsDemo();
     runHeapDemo();
     
     return 0;
@@ -0,0 +1,99 @@
+#ifndef OUTPUT_SINK_H
+#define OUTPUT_SINK_H
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <charconv>
+
+// ==========================================================
+// --- Buffered Output Sink (shared by all list/tree printers) ---
+// ==========================================================
+
+// Printers render into one large reusable buffer (integers via std::to_chars)
+// and hand it to the target stream in big writes, instead of several
+// operator<< calls per element. Because the bytes still go through the same
+// ostream, output stays correctly ordered with ordinary cout calls as long as
+// each printer calls flush() before it returns.
+class OutputSink {
+private:
+    std::ostream* out;
+    char* buffer;
+    std::size_t capacity;
+    std::size_t used;
+
+    void ensure(std::size_t bytes) {
+        if (used + bytes > capacity) {
+            flush();
+        }
+    }
+
+public:
+    explicit OutputSink(std::ostream& target, std::size_t bufferSize = 1 << 16)
+        : out(&target), buffer(new char[bufferSize]), capacity(bufferSize), used(0) {}
+
+    ~OutputSink() {
+        flush();
+        delete[] buffer;
+    }
+
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+
+    // Switches the destination stream (pending bytes go to the old one first)
+    void retarget(std::ostream& target) {
+        if (out != &target) {
+            flush();
+            out = &target;
+        }
+    }
+
+    OutputSink& text(const char* str, std::size_t length) {
+        if (length > capacity) {
+            flush();
+            out->write(str, (std::streamsize)length);
+            return *this;
+        }
+        ensure(length);
+        std::memcpy(buffer + used, str, length);
+        used += length;
+        return *this;
+    }
+
+    OutputSink& text(const char* str) { return text(str, std::strlen(str)); }
+    OutputSink& text(const std::string& str) { return text(str.data(), str.size()); }
+
+    OutputSink& character(char c) {
+        ensure(1);
+        buffer[used++] = c;
+        return *this;
+    }
+
+    OutputSink& integer(long long value) {
+        ensure(24); // Enough for any 64-bit integer
+        std::to_chars_result result = std::to_chars(buffer + used, buffer + capacity, value);
+        used = (std::size_t)(result.ptr - buffer);
+        return *this;
+    }
+
+    // Raw binary dump mode: copies 'bytes' bytes from data unformatted
+    OutputSink& binary(const void* data, std::size_t bytes) {
+        return text((const char*)data, bytes);
+    }
+
+    void flush() {
+        if (used > 0) {
+            out->write(buffer, (std::streamsize)used);
+            used = 0;
+        }
+    }
+};
+
+// Shared sink with a single reusable buffer, pointed at the requested stream
+inline OutputSink& outputSink(std::ostream& target = std::cout) {
+    static OutputSink sink(std::cout, 1 << 20);
+    sink.retarget(target);
+    return sink;
+}
+
+#endif